@@ -4,6 +4,15 @@
 #include <time.h>   // For clock_gettime
 #include <stdbool.h>
 
+// Unity build, for the distribution batch fills (link with -lm):
+//   gcc -o benchmark benchmark.c -O3 -march=native -lm
+// Only a few of the library's static functions are timed, so silence the unused-function
+// warnings for the rest.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#include "biski64_dist.c"
+#pragma GCC diagnostic pop
+
 // --- State Variables (Global for this benchmark) ---
 // Seeded with dummy data for the benchmark
 
@@ -269,7 +278,66 @@ int main(int argc, char **argv) {
     printf("  PCG128_XSL_RR_64 ns/call: %.3f ns\n", ns_per_call);
 
 
+    // --- Benchmark distribution samplers ---
+    // Batch fills write BENCH_BATCH values per call; times are reported per value.
+    enum { BENCH_BATCH = 4096 };
+    static double batch[BENCH_BATCH];
+    volatile double dummyDouble = 0.0;
+    const uint64_t num_batches = (num_iterations + BENCH_BATCH - 1) / BENCH_BATCH;
+    const double num_values = (double)num_batches * BENCH_BATCH;
+
+    biski64_state dist_state;
+    biski64x8_state dist_x8;
+    biski64_seed(&dist_state, 42);
+    biski64x8_seed(&dist_x8, 42);
+
+    printf("\nBenchmarking distribution samplers (kernel: %s)...\n", biski64_kernel_name());
+
+    // For an even playing field make sure that all benchmarking loops are equivalently aligned
+    asm volatile (".balign 16");
+
+    start_time = get_time_sec();
+    for (uint64_t i = 0; i < num_iterations; ++i)
+        dummyDouble = biski64_exponential(&dist_state);
+
+    end_time = get_time_sec();
+    duration = end_time - start_time;
+    ns_per_call = (duration * 1e9) / num_iterations;
+    printf("  biski64_exponential ns/value:        %.3f ns\n", ns_per_call);
+
+
+    // For an even playing field make sure that all benchmarking loops are equivalently aligned
+    asm volatile (".balign 16");
+
+    start_time = get_time_sec();
+    for (uint64_t i = 0; i < num_batches; ++i) {
+        biski64x8_fill_exponential(&dist_x8, batch, BENCH_BATCH, 1.0);
+        dummyDouble = batch[i % BENCH_BATCH];
+    }
+
+    end_time = get_time_sec();
+    duration = end_time - start_time;
+    ns_per_call = (duration * 1e9) / num_values;
+    printf("  biski64x8_fill_exponential ns/value: %.3f ns\n", ns_per_call);
+
+
+    // For an even playing field make sure that all benchmarking loops are equivalently aligned
+    asm volatile (".balign 16");
+
+    start_time = get_time_sec();
+    for (uint64_t i = 0; i < num_batches; ++i) {
+        biski64x8_fill_laplace(&dist_x8, batch, BENCH_BATCH, 0.0, 1.0);
+        dummyDouble = batch[i % BENCH_BATCH];
+    }
+
+    end_time = get_time_sec();
+    duration = end_time - start_time;
+    ns_per_call = (duration * 1e9) / num_values;
+    printf("  biski64x8_fill_laplace ns/value:     %.3f ns\n", ns_per_call);
+
+
     printf("\nBenchmark complete.\n");
+    (void)dummyDouble;
     (void)dummyVar; // To prevent unused variable warning if iterations are zero.
     return 0;
 }
@@ -1,5 +1,18 @@
+#ifndef BISKI64_C
+#define BISKI64_C
+
 #include <stdint.h> // For uint64_t and standard integer types
+#include <stddef.h> // For size_t
 #include <stdio.h>  // For printf
+#include <stdlib.h> // For getenv
+#include <string.h> // For strcmp
+
+// Vector kernels are built with per-function target attributes on x86-64 GCC/Clang.
+// Define BISKI64_DONT_USE_SIMD to restrict the library to portable scalar code.
+#if !defined(BISKI64_DONT_USE_SIMD) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BISKI64_X86_SIMD
+#include <immintrin.h>
+#endif
 
 
 /**
@@ -152,3 +165,1810 @@ static uint64_t biski64_next(biski64_state* state) {
 
     return output;
 }
+
+
+/**
+ * @internal
+ * @brief Advances one generator held as three separate state variables.
+ *
+ * Identical to biski64_next(), but operates on the lane-indexed variables of the
+ * multi-lane engines so that their scalar paths stay bit-exact with the scalar generator.
+ *
+ * @return A 64-bit pseudo-random unsigned integer.
+ */
+static inline uint64_t biski64_next_lane(uint64_t* fast_loop, uint64_t* mix, uint64_t* loop_mix) {
+    const uint64_t output = *mix + *loop_mix;
+    const uint64_t old_loop_mix = *loop_mix;
+
+    *loop_mix = *fast_loop ^ *mix;
+    *mix = rotate_left(*mix, 16) + rotate_left(old_loop_mix, 40);
+    *fast_loop += 0x9999999999999999ULL;
+
+    return output;
+}
+
+
+/**
+ * @brief State structure for the four-lane biski64x4 engine.
+ *
+ * Holds four independent biski64 generators in structure-of-arrays layout, so that
+ * each state variable loads directly into one 256-bit register (lane k in element k).
+ * This structure should be initialized via biski64x4_seed() or biski64x4_stream().
+ */
+typedef struct {
+    uint64_t fast_loop[4];
+    uint64_t mix[4];
+    uint64_t loop_mix[4];
+} biski64x4_state;
+
+
+#ifndef BISKI64_DONT_USE_PARALLEL_STREAMS
+/**
+ * @brief Initializes a biski64x4 engine as four consecutive parallel streams.
+ *
+ * Lane k is seeded exactly as biski64_stream(seed, streamIndex * 4 + k, totalNumStreams * 4),
+ * so every lane is a well-separated stream and lane k reproduces that scalar stream bit for bit.
+ *
+ * @param state Pointer to the biski64x4_state structure to be initialized.
+ * The caller must ensure this pointer is not NULL.
+ * @param seed The base 64-bit value shared by all streams.
+ * @param streamIndex The index of this engine (0 to totalNumStreams-1).
+ * @param totalNumStreams The total number of biski64x4 engines sharing the seed.
+ */
+static void biski64x4_stream(biski64x4_state* state, uint64_t seed, int streamIndex, int totalNumStreams) {
+    for (int k = 0; k < 4; ++k) {
+        biski64_state lane;
+        biski64_stream(&lane, seed, streamIndex * 4 + k, totalNumStreams * 4);
+
+        state->fast_loop[k] = lane.fast_loop;
+        state->mix[k]       = lane.mix;
+        state->loop_mix[k]  = lane.loop_mix;
+    }
+}
+
+
+/**
+ * @brief Initializes a biski64x4 engine from a single 64-bit seed.
+ *
+ * Lane k matches biski64_stream(seed, k, 4).
+ *
+ * @param state Pointer to the biski64x4_state structure to be initialized.
+ * @param seed  The 64-bit value to use as the seed.
+ */
+static void biski64x4_seed(biski64x4_state* state, uint64_t seed) {
+    biski64x4_stream(state, seed, 0, 1);
+}
+#endif // BISKI64_DONT_USE_PARALLEL_STREAMS
+
+
+/**
+ * @internal
+ * @brief Portable implementation of biski64x4_fill().
+ */
+static void biski64x4_fill_scalar(biski64x4_state* state, uint64_t* out, size_t n) {
+    const size_t full = n - n % 4;
+
+    for (size_t i = 0; i < full; i += 4)
+        for (int k = 0; k < 4; ++k)
+            out[i + k] = biski64_next_lane(&state->fast_loop[k], &state->mix[k], &state->loop_mix[k]);
+
+    for (size_t k = 0; k < n % 4; ++k)
+        out[full + k] = biski64_next_lane(&state->fast_loop[k], &state->mix[k], &state->loop_mix[k]);
+}
+
+
+#ifdef BISKI64_X86_SIMD
+/**
+ * @internal
+ * @brief AVX2 implementation of biski64x4_fill().
+ *
+ * Both rotations are whole-byte amounts (16 = 2 bytes, 40 = 5 bytes), so each is a single
+ * vpshufb instead of the shift/shift/or sequence AVX2 would otherwise need.
+ * The caller must ensure the CPU supports AVX2.
+ */
+__attribute__((target("avx2")))
+static void biski64x4_fill_avx2(biski64x4_state* state, uint64_t* out, size_t n) {
+    const __m256i rot16 = _mm256_setr_epi8(6, 7, 0, 1, 2, 3, 4, 5, 14, 15, 8, 9, 10, 11, 12, 13,
+                                           6, 7, 0, 1, 2, 3, 4, 5, 14, 15, 8, 9, 10, 11, 12, 13);
+    const __m256i rot40 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+                                           3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+    const __m256i weyl  = _mm256_set1_epi64x((long long)0x9999999999999999ULL);
+
+    __m256i fast_loop = _mm256_loadu_si256((const __m256i*)state->fast_loop);
+    __m256i mix       = _mm256_loadu_si256((const __m256i*)state->mix);
+    __m256i loop_mix  = _mm256_loadu_si256((const __m256i*)state->loop_mix);
+
+    const size_t full = n - n % 4;
+
+    for (size_t i = 0; i < full; i += 4) {
+        const __m256i output = _mm256_add_epi64(mix, loop_mix);
+        const __m256i old_loop_mix = loop_mix;
+
+        loop_mix  = _mm256_xor_si256(fast_loop, mix);
+        mix       = _mm256_add_epi64(_mm256_shuffle_epi8(mix, rot16),
+                                     _mm256_shuffle_epi8(old_loop_mix, rot40));
+        fast_loop = _mm256_add_epi64(fast_loop, weyl);
+
+        _mm256_storeu_si256((__m256i*)(out + i), output);
+    }
+
+    _mm256_storeu_si256((__m256i*)state->fast_loop, fast_loop);
+    _mm256_storeu_si256((__m256i*)state->mix, mix);
+    _mm256_storeu_si256((__m256i*)state->loop_mix, loop_mix);
+
+    for (size_t k = 0; k < n % 4; ++k)
+        out[full + k] = biski64_next_lane(&state->fast_loop[k], &state->mix[k], &state->loop_mix[k]);
+}
+
+
+/**
+ * @internal
+ * @brief AVX-512VL implementation of biski64x4_fill().
+ *
+ * Same as biski64x4_fill_avx2(), but with vprolq on 256-bit registers for the rotations.
+ * The caller must ensure the CPU supports AVX-512F and AVX-512VL.
+ */
+__attribute__((target("avx512f,avx512vl")))
+static void biski64x4_fill_avx512(biski64x4_state* state, uint64_t* out, size_t n) {
+    const __m256i weyl = _mm256_set1_epi64x((long long)0x9999999999999999ULL);
+
+    __m256i fast_loop = _mm256_loadu_si256((const __m256i*)state->fast_loop);
+    __m256i mix       = _mm256_loadu_si256((const __m256i*)state->mix);
+    __m256i loop_mix  = _mm256_loadu_si256((const __m256i*)state->loop_mix);
+
+    const size_t full = n - n % 4;
+
+    for (size_t i = 0; i < full; i += 4) {
+        const __m256i output = _mm256_add_epi64(mix, loop_mix);
+        const __m256i old_loop_mix = loop_mix;
+
+        loop_mix  = _mm256_xor_si256(fast_loop, mix);
+        mix       = _mm256_add_epi64(_mm256_rol_epi64(mix, 16), _mm256_rol_epi64(old_loop_mix, 40));
+        fast_loop = _mm256_add_epi64(fast_loop, weyl);
+
+        _mm256_storeu_si256((__m256i*)(out + i), output);
+    }
+
+    _mm256_storeu_si256((__m256i*)state->fast_loop, fast_loop);
+    _mm256_storeu_si256((__m256i*)state->mix, mix);
+    _mm256_storeu_si256((__m256i*)state->loop_mix, loop_mix);
+
+    for (size_t k = 0; k < n % 4; ++k)
+        out[full + k] = biski64_next_lane(&state->fast_loop[k], &state->mix[k], &state->loop_mix[k]);
+}
+#endif // BISKI64_X86_SIMD
+
+
+/**
+ * @brief State structure for the eight-lane biski64x8 engine.
+ *
+ * Holds eight independent biski64 generators in structure-of-arrays layout, so that
+ * each state variable loads directly into one 512-bit register (lane k in element k).
+ * This structure should be initialized via biski64x8_seed() or biski64x8_stream().
+ */
+typedef struct {
+    uint64_t fast_loop[8];
+    uint64_t mix[8];
+    uint64_t loop_mix[8];
+} biski64x8_state;
+
+
+#ifndef BISKI64_DONT_USE_PARALLEL_STREAMS
+/**
+ * @brief Initializes a biski64x8 engine as eight consecutive parallel streams.
+ *
+ * Lane k is seeded exactly as biski64_stream(seed, streamIndex * 8 + k, totalNumStreams * 8),
+ * so every lane is a well-separated stream and lane k reproduces that scalar stream bit for bit.
+ *
+ * @param state Pointer to the biski64x8_state structure to be initialized.
+ * The caller must ensure this pointer is not NULL.
+ * @param seed The base 64-bit value shared by all streams.
+ * @param streamIndex The index of this engine (0 to totalNumStreams-1).
+ * @param totalNumStreams The total number of biski64x8 engines sharing the seed.
+ */
+static void biski64x8_stream(biski64x8_state* state, uint64_t seed, int streamIndex, int totalNumStreams) {
+    for (int k = 0; k < 8; ++k) {
+        biski64_state lane;
+        biski64_stream(&lane, seed, streamIndex * 8 + k, totalNumStreams * 8);
+
+        state->fast_loop[k] = lane.fast_loop;
+        state->mix[k]       = lane.mix;
+        state->loop_mix[k]  = lane.loop_mix;
+    }
+}
+
+
+/**
+ * @brief Initializes a biski64x8 engine from a single 64-bit seed.
+ *
+ * Lane k matches biski64_stream(seed, k, 8).
+ *
+ * @param state Pointer to the biski64x8_state structure to be initialized.
+ * @param seed  The 64-bit value to use as the seed.
+ */
+static void biski64x8_seed(biski64x8_state* state, uint64_t seed) {
+    biski64x8_stream(state, seed, 0, 1);
+}
+#endif // BISKI64_DONT_USE_PARALLEL_STREAMS
+
+
+/**
+ * @brief Copies lane k of a biski64x8 engine into a scalar biski64_state.
+ *
+ * Together with biski64x8_set_lane() this lets scalar code draw the occasional extra value
+ * from a lane between bulk fills. The caller must ensure 0 <= k < 8.
+ */
+static inline biski64_state biski64x8_get_lane(const biski64x8_state* state, int k) {
+    biski64_state lane;
+    lane.fast_loop = state->fast_loop[k];
+    lane.mix       = state->mix[k];
+    lane.loop_mix  = state->loop_mix[k];
+    return lane;
+}
+
+
+/**
+ * @brief Stores a scalar biski64_state back into lane k of a biski64x8 engine.
+ */
+static inline void biski64x8_set_lane(biski64x8_state* state, int k, const biski64_state* lane) {
+    state->fast_loop[k] = lane->fast_loop;
+    state->mix[k]       = lane->mix;
+    state->loop_mix[k]  = lane->loop_mix;
+}
+
+
+/**
+ * @internal
+ * @brief Portable implementation of biski64x8_fill().
+ */
+static void biski64x8_fill_scalar(biski64x8_state* state, uint64_t* out, size_t n) {
+    const size_t full = n - n % 8;
+
+    for (size_t i = 0; i < full; i += 8)
+        for (int k = 0; k < 8; ++k)
+            out[i + k] = biski64_next_lane(&state->fast_loop[k], &state->mix[k], &state->loop_mix[k]);
+
+    for (size_t k = 0; k < n % 8; ++k)
+        out[full + k] = biski64_next_lane(&state->fast_loop[k], &state->mix[k], &state->loop_mix[k]);
+}
+
+
+#ifdef BISKI64_X86_SIMD
+/**
+ * @internal
+ * @brief AVX2 implementation of biski64x8_fill().
+ *
+ * Runs lanes 0-3 and 4-7 as two independent 256-bit chains, which also gives the
+ * out-of-order core two dependency chains to overlap.
+ * The caller must ensure the CPU supports AVX2.
+ */
+__attribute__((target("avx2")))
+static void biski64x8_fill_avx2(biski64x8_state* state, uint64_t* out, size_t n) {
+    const __m256i rot16 = _mm256_setr_epi8(6, 7, 0, 1, 2, 3, 4, 5, 14, 15, 8, 9, 10, 11, 12, 13,
+                                           6, 7, 0, 1, 2, 3, 4, 5, 14, 15, 8, 9, 10, 11, 12, 13);
+    const __m256i rot40 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+                                           3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+    const __m256i weyl  = _mm256_set1_epi64x((long long)0x9999999999999999ULL);
+
+    __m256i fast_loop_a = _mm256_loadu_si256((const __m256i*)state->fast_loop);
+    __m256i mix_a       = _mm256_loadu_si256((const __m256i*)state->mix);
+    __m256i loop_mix_a  = _mm256_loadu_si256((const __m256i*)state->loop_mix);
+    __m256i fast_loop_b = _mm256_loadu_si256((const __m256i*)(state->fast_loop + 4));
+    __m256i mix_b       = _mm256_loadu_si256((const __m256i*)(state->mix + 4));
+    __m256i loop_mix_b  = _mm256_loadu_si256((const __m256i*)(state->loop_mix + 4));
+
+    const size_t full = n - n % 8;
+
+    for (size_t i = 0; i < full; i += 8) {
+        const __m256i output_a = _mm256_add_epi64(mix_a, loop_mix_a);
+        const __m256i output_b = _mm256_add_epi64(mix_b, loop_mix_b);
+        const __m256i old_loop_mix_a = loop_mix_a;
+        const __m256i old_loop_mix_b = loop_mix_b;
+
+        loop_mix_a  = _mm256_xor_si256(fast_loop_a, mix_a);
+        loop_mix_b  = _mm256_xor_si256(fast_loop_b, mix_b);
+        mix_a       = _mm256_add_epi64(_mm256_shuffle_epi8(mix_a, rot16),
+                                       _mm256_shuffle_epi8(old_loop_mix_a, rot40));
+        mix_b       = _mm256_add_epi64(_mm256_shuffle_epi8(mix_b, rot16),
+                                       _mm256_shuffle_epi8(old_loop_mix_b, rot40));
+        fast_loop_a = _mm256_add_epi64(fast_loop_a, weyl);
+        fast_loop_b = _mm256_add_epi64(fast_loop_b, weyl);
+
+        _mm256_storeu_si256((__m256i*)(out + i), output_a);
+        _mm256_storeu_si256((__m256i*)(out + i + 4), output_b);
+    }
+
+    _mm256_storeu_si256((__m256i*)state->fast_loop, fast_loop_a);
+    _mm256_storeu_si256((__m256i*)state->mix, mix_a);
+    _mm256_storeu_si256((__m256i*)state->loop_mix, loop_mix_a);
+    _mm256_storeu_si256((__m256i*)(state->fast_loop + 4), fast_loop_b);
+    _mm256_storeu_si256((__m256i*)(state->mix + 4), mix_b);
+    _mm256_storeu_si256((__m256i*)(state->loop_mix + 4), loop_mix_b);
+
+    for (size_t k = 0; k < n % 8; ++k)
+        out[full + k] = biski64_next_lane(&state->fast_loop[k], &state->mix[k], &state->loop_mix[k]);
+}
+
+
+/**
+ * @internal
+ * @brief AVX-512 implementation of biski64x8_fill().
+ *
+ * AVX-512F has native 64-bit rotates, so rotate_left() maps to a single vprolq and one
+ * step is five vector instructions plus the store.
+ * The caller must ensure the CPU supports AVX-512F.
+ */
+__attribute__((target("avx512f")))
+static void biski64x8_fill_avx512(biski64x8_state* state, uint64_t* out, size_t n) {
+    const __m512i weyl = _mm512_set1_epi64((long long)0x9999999999999999ULL);
+
+    __m512i fast_loop = _mm512_loadu_si512(state->fast_loop);
+    __m512i mix       = _mm512_loadu_si512(state->mix);
+    __m512i loop_mix  = _mm512_loadu_si512(state->loop_mix);
+
+    const size_t full = n - n % 8;
+
+    for (size_t i = 0; i < full; i += 8) {
+        const __m512i output = _mm512_add_epi64(mix, loop_mix);
+        const __m512i old_loop_mix = loop_mix;
+
+        loop_mix  = _mm512_xor_si512(fast_loop, mix);
+        mix       = _mm512_add_epi64(_mm512_rol_epi64(mix, 16), _mm512_rol_epi64(old_loop_mix, 40));
+        fast_loop = _mm512_add_epi64(fast_loop, weyl);
+
+        _mm512_storeu_si512(out + i, output);
+    }
+
+    _mm512_storeu_si512(state->fast_loop, fast_loop);
+    _mm512_storeu_si512(state->mix, mix);
+    _mm512_storeu_si512(state->loop_mix, loop_mix);
+
+    for (size_t k = 0; k < n % 8; ++k)
+        out[full + k] = biski64_next_lane(&state->fast_loop[k], &state->mix[k], &state->loop_mix[k]);
+}
+#endif // BISKI64_X86_SIMD
+
+
+/**
+ * @internal
+ * @brief Maps an output to a double in [1, 2) by setting the exponent of 1.0 over the top
+ * 52 bits, then subtracts offset.
+ */
+static inline double biski64_to_double(uint64_t x, double offset) {
+    const uint64_t bits = (x >> 12) | 0x3FF0000000000000ULL;
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d - offset;
+}
+
+
+/**
+ * @internal
+ * @brief Maps 32 random bits to a float in [1, 2) by setting the exponent of 1.0f over the
+ * top 23 bits, then subtracts offset.
+ */
+static inline float biski64_to_float(uint32_t x, float offset) {
+    const uint32_t bits = (x >> 9) | 0x3F800000U;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f - offset;
+}
+
+
+/**
+ * @internal
+ * @brief Writes the final n % 8 doubles of a biski64x8 double fill from lanes 0 to n % 8 - 1.
+ */
+static void biski64x8_fill_double_tail(biski64x8_state* state, double* out, size_t r, double offset) {
+    for (size_t k = 0; k < r; ++k)
+        out[k] = biski64_to_double(biski64_next_lane(&state->fast_loop[k], &state->mix[k], &state->loop_mix[k]), offset);
+}
+
+
+/**
+ * @internal
+ * @brief Writes the final n % 16 floats of a biski64x8 float fill, two per output from lanes
+ * 0 upward. For an odd count the high half of the last output is discarded.
+ */
+static void biski64x8_fill_float_tail(biski64x8_state* state, float* out, size_t r, float offset) {
+    for (size_t k = 0; 2 * k < r; ++k) {
+        const uint64_t x = biski64_next_lane(&state->fast_loop[k], &state->mix[k], &state->loop_mix[k]);
+        out[2 * k] = biski64_to_float((uint32_t)x, offset);
+        if (2 * k + 1 < r)
+            out[2 * k + 1] = biski64_to_float((uint32_t)(x >> 32), offset);
+    }
+}
+
+
+/**
+ * @internal
+ * @brief Portable implementation of the biski64x8 double fills.
+ */
+static void biski64x8_fill_double_scalar(biski64x8_state* state, double* out, size_t n, double offset) {
+    const size_t full = n - n % 8;
+
+    for (size_t i = 0; i < full; i += 8)
+        for (int k = 0; k < 8; ++k)
+            out[i + k] = biski64_to_double(biski64_next_lane(&state->fast_loop[k], &state->mix[k], &state->loop_mix[k]), offset);
+
+    biski64x8_fill_double_tail(state, out + full, n % 8, offset);
+}
+
+
+/**
+ * @internal
+ * @brief Portable implementation of the biski64x8 float fills.
+ */
+static void biski64x8_fill_float_scalar(biski64x8_state* state, float* out, size_t n, float offset) {
+    const size_t full = n - n % 16;
+
+    for (size_t i = 0; i < full; i += 16)
+        for (int k = 0; k < 8; ++k) {
+            const uint64_t x = biski64_next_lane(&state->fast_loop[k], &state->mix[k], &state->loop_mix[k]);
+            out[i + 2 * k]     = biski64_to_float((uint32_t)x, offset);
+            out[i + 2 * k + 1] = biski64_to_float((uint32_t)(x >> 32), offset);
+        }
+
+    biski64x8_fill_float_tail(state, out + full, n % 16, offset);
+}
+
+
+#ifdef BISKI64_X86_SIMD
+/**
+ * @internal
+ * @brief One biski64 step on four lanes held in 256-bit registers. Returns the outputs.
+ */
+__attribute__((target("avx2")))
+static inline __m256i biski64_step_avx2(__m256i* fast_loop, __m256i* mix, __m256i* loop_mix) {
+    const __m256i rot16 = _mm256_setr_epi8(6, 7, 0, 1, 2, 3, 4, 5, 14, 15, 8, 9, 10, 11, 12, 13,
+                                           6, 7, 0, 1, 2, 3, 4, 5, 14, 15, 8, 9, 10, 11, 12, 13);
+    const __m256i rot40 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+                                           3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+
+    const __m256i output = _mm256_add_epi64(*mix, *loop_mix);
+    const __m256i old_loop_mix = *loop_mix;
+
+    *loop_mix  = _mm256_xor_si256(*fast_loop, *mix);
+    *mix       = _mm256_add_epi64(_mm256_shuffle_epi8(*mix, rot16), _mm256_shuffle_epi8(old_loop_mix, rot40));
+    *fast_loop = _mm256_add_epi64(*fast_loop, _mm256_set1_epi64x((long long)0x9999999999999999ULL));
+
+    return output;
+}
+
+
+/**
+ * @internal
+ * @brief One biski64 step on eight lanes held in 512-bit registers. Returns the outputs.
+ */
+__attribute__((target("avx512f")))
+static inline __m512i biski64_step_avx512(__m512i* fast_loop, __m512i* mix, __m512i* loop_mix) {
+    const __m512i output = _mm512_add_epi64(*mix, *loop_mix);
+    const __m512i old_loop_mix = *loop_mix;
+
+    *loop_mix  = _mm512_xor_si512(*fast_loop, *mix);
+    *mix       = _mm512_add_epi64(_mm512_rol_epi64(*mix, 16), _mm512_rol_epi64(old_loop_mix, 40));
+    *fast_loop = _mm512_add_epi64(*fast_loop, _mm512_set1_epi64((long long)0x9999999999999999ULL));
+
+    return output;
+}
+
+
+/**
+ * @internal
+ * @brief AVX2 implementation of the biski64x8 double fills: generation and conversion in
+ * one pass, so the outputs never leave registers as integers.
+ * The caller must ensure the CPU supports AVX2.
+ */
+__attribute__((target("avx2")))
+static void biski64x8_fill_double_avx2(biski64x8_state* state, double* out, size_t n, double offset) {
+    const __m256i exponent = _mm256_set1_epi64x(0x3FF0000000000000LL);
+    const __m256d sub      = _mm256_set1_pd(offset);
+
+    __m256i fast_loop_a = _mm256_loadu_si256((const __m256i*)state->fast_loop);
+    __m256i mix_a       = _mm256_loadu_si256((const __m256i*)state->mix);
+    __m256i loop_mix_a  = _mm256_loadu_si256((const __m256i*)state->loop_mix);
+    __m256i fast_loop_b = _mm256_loadu_si256((const __m256i*)(state->fast_loop + 4));
+    __m256i mix_b       = _mm256_loadu_si256((const __m256i*)(state->mix + 4));
+    __m256i loop_mix_b  = _mm256_loadu_si256((const __m256i*)(state->loop_mix + 4));
+
+    const size_t full = n - n % 8;
+
+    for (size_t i = 0; i < full; i += 8) {
+        const __m256i output_a = biski64_step_avx2(&fast_loop_a, &mix_a, &loop_mix_a);
+        const __m256i output_b = biski64_step_avx2(&fast_loop_b, &mix_b, &loop_mix_b);
+
+        _mm256_storeu_pd(out + i,     _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(output_a, 12), exponent)), sub));
+        _mm256_storeu_pd(out + i + 4, _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(output_b, 12), exponent)), sub));
+    }
+
+    _mm256_storeu_si256((__m256i*)state->fast_loop, fast_loop_a);
+    _mm256_storeu_si256((__m256i*)state->mix, mix_a);
+    _mm256_storeu_si256((__m256i*)state->loop_mix, loop_mix_a);
+    _mm256_storeu_si256((__m256i*)(state->fast_loop + 4), fast_loop_b);
+    _mm256_storeu_si256((__m256i*)(state->mix + 4), mix_b);
+    _mm256_storeu_si256((__m256i*)(state->loop_mix + 4), loop_mix_b);
+
+    biski64x8_fill_double_tail(state, out + full, n % 8, offset);
+}
+
+
+/**
+ * @internal
+ * @brief AVX2 implementation of the biski64x8 float fills (two floats per output).
+ * The caller must ensure the CPU supports AVX2.
+ */
+__attribute__((target("avx2")))
+static void biski64x8_fill_float_avx2(biski64x8_state* state, float* out, size_t n, float offset) {
+    const __m256i exponent = _mm256_set1_epi32(0x3F800000);
+    const __m256  sub      = _mm256_set1_ps(offset);
+
+    __m256i fast_loop_a = _mm256_loadu_si256((const __m256i*)state->fast_loop);
+    __m256i mix_a       = _mm256_loadu_si256((const __m256i*)state->mix);
+    __m256i loop_mix_a  = _mm256_loadu_si256((const __m256i*)state->loop_mix);
+    __m256i fast_loop_b = _mm256_loadu_si256((const __m256i*)(state->fast_loop + 4));
+    __m256i mix_b       = _mm256_loadu_si256((const __m256i*)(state->mix + 4));
+    __m256i loop_mix_b  = _mm256_loadu_si256((const __m256i*)(state->loop_mix + 4));
+
+    const size_t full = n - n % 16;
+
+    for (size_t i = 0; i < full; i += 16) {
+        const __m256i output_a = biski64_step_avx2(&fast_loop_a, &mix_a, &loop_mix_a);
+        const __m256i output_b = biski64_step_avx2(&fast_loop_b, &mix_b, &loop_mix_b);
+
+        _mm256_storeu_ps(out + i,     _mm256_sub_ps(_mm256_castsi256_ps(_mm256_or_si256(_mm256_srli_epi32(output_a, 9), exponent)), sub));
+        _mm256_storeu_ps(out + i + 8, _mm256_sub_ps(_mm256_castsi256_ps(_mm256_or_si256(_mm256_srli_epi32(output_b, 9), exponent)), sub));
+    }
+
+    _mm256_storeu_si256((__m256i*)state->fast_loop, fast_loop_a);
+    _mm256_storeu_si256((__m256i*)state->mix, mix_a);
+    _mm256_storeu_si256((__m256i*)state->loop_mix, loop_mix_a);
+    _mm256_storeu_si256((__m256i*)(state->fast_loop + 4), fast_loop_b);
+    _mm256_storeu_si256((__m256i*)(state->mix + 4), mix_b);
+    _mm256_storeu_si256((__m256i*)(state->loop_mix + 4), loop_mix_b);
+
+    biski64x8_fill_float_tail(state, out + full, n % 16, offset);
+}
+
+
+/**
+ * @internal
+ * @brief AVX-512 implementation of the biski64x8 double fills.
+ * The caller must ensure the CPU supports AVX-512F.
+ */
+__attribute__((target("avx512f")))
+static void biski64x8_fill_double_avx512(biski64x8_state* state, double* out, size_t n, double offset) {
+    const __m512i exponent = _mm512_set1_epi64(0x3FF0000000000000LL);
+    const __m512d sub      = _mm512_set1_pd(offset);
+
+    __m512i fast_loop = _mm512_loadu_si512(state->fast_loop);
+    __m512i mix       = _mm512_loadu_si512(state->mix);
+    __m512i loop_mix  = _mm512_loadu_si512(state->loop_mix);
+
+    const size_t full = n - n % 8;
+
+    for (size_t i = 0; i < full; i += 8) {
+        const __m512i output = biski64_step_avx512(&fast_loop, &mix, &loop_mix);
+        _mm512_storeu_pd(out + i, _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(output, 12), exponent)), sub));
+    }
+
+    _mm512_storeu_si512(state->fast_loop, fast_loop);
+    _mm512_storeu_si512(state->mix, mix);
+    _mm512_storeu_si512(state->loop_mix, loop_mix);
+
+    biski64x8_fill_double_tail(state, out + full, n % 8, offset);
+}
+
+
+/**
+ * @internal
+ * @brief AVX-512 implementation of the biski64x8 float fills (two floats per output).
+ * The caller must ensure the CPU supports AVX-512F.
+ */
+__attribute__((target("avx512f")))
+static void biski64x8_fill_float_avx512(biski64x8_state* state, float* out, size_t n, float offset) {
+    const __m512i exponent = _mm512_set1_epi32(0x3F800000);
+    const __m512  sub      = _mm512_set1_ps(offset);
+
+    __m512i fast_loop = _mm512_loadu_si512(state->fast_loop);
+    __m512i mix       = _mm512_loadu_si512(state->mix);
+    __m512i loop_mix  = _mm512_loadu_si512(state->loop_mix);
+
+    const size_t full = n - n % 16;
+
+    for (size_t i = 0; i < full; i += 16) {
+        const __m512i output = biski64_step_avx512(&fast_loop, &mix, &loop_mix);
+        _mm512_storeu_ps(out + i, _mm512_sub_ps(_mm512_castsi512_ps(_mm512_or_si512(_mm512_srli_epi32(output, 9), exponent)), sub));
+    }
+
+    _mm512_storeu_si512(state->fast_loop, fast_loop);
+    _mm512_storeu_si512(state->mix, mix);
+    _mm512_storeu_si512(state->loop_mix, loop_mix);
+
+    biski64x8_fill_float_tail(state, out + full, n % 16, offset);
+}
+#endif // BISKI64_X86_SIMD
+
+
+/**
+ * @brief Instruction-set tiers that the bulk kernels are compiled for.
+ */
+typedef enum {
+    BISKI64_KERNEL_SCALAR = 0,
+    BISKI64_KERNEL_AVX2   = 1,
+    BISKI64_KERNEL_AVX512 = 2
+} biski64_kernel;
+
+
+/**
+ * @internal
+ * @brief Bulk fill entry points bound to one instruction-set tier.
+ */
+typedef struct {
+    biski64_kernel kernel;
+    const char* name;
+    void (*fill_x4)(biski64x4_state* state, uint64_t* out, size_t n);
+    void (*fill_x8)(biski64x8_state* state, uint64_t* out, size_t n);
+    void (*fill_double)(biski64x8_state* state, double* out, size_t n, double offset);
+    void (*fill_float)(biski64x8_state* state, float* out, size_t n, float offset);
+} biski64_kernel_table;
+
+
+static const biski64_kernel_table biski64_kernel_tables[] = {
+    { BISKI64_KERNEL_SCALAR, "scalar", biski64x4_fill_scalar, biski64x8_fill_scalar,
+      biski64x8_fill_double_scalar, biski64x8_fill_float_scalar },
+#ifdef BISKI64_X86_SIMD
+    { BISKI64_KERNEL_AVX2,   "avx2",   biski64x4_fill_avx2,   biski64x8_fill_avx2,
+      biski64x8_fill_double_avx2,   biski64x8_fill_float_avx2 },
+    { BISKI64_KERNEL_AVX512, "avx512", biski64x4_fill_avx512, biski64x8_fill_avx512,
+      biski64x8_fill_double_avx512, biski64x8_fill_float_avx512 },
+#endif
+};
+
+
+#ifdef BISKI64_X86_SIMD
+/**
+ * @internal
+ * @brief Probes CPUID and selects the kernel table for this process.
+ *
+ * The best tier the CPU (and OS, via XCR0) supports is chosen. The BISKI64_KERNEL environment
+ * variable ("scalar", "avx2" or "avx512") overrides the choice for benchmarking; a request for
+ * a tier the CPU cannot run is capped at the best supported tier.
+ */
+static const biski64_kernel_table* biski64_select_kernels(void) {
+    __builtin_cpu_init();
+
+    biski64_kernel best = BISKI64_KERNEL_SCALAR;
+    if (__builtin_cpu_supports("avx2"))
+        best = BISKI64_KERNEL_AVX2;
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl"))
+        best = BISKI64_KERNEL_AVX512;
+
+    biski64_kernel chosen = best;
+    const char* forced = getenv("BISKI64_KERNEL");
+    if (forced != NULL) {
+        for (size_t t = 0; t < sizeof(biski64_kernel_tables) / sizeof(biski64_kernel_tables[0]); ++t)
+            if (strcmp(forced, biski64_kernel_tables[t].name) == 0 && biski64_kernel_tables[t].kernel < best)
+                chosen = biski64_kernel_tables[t].kernel;
+    }
+
+    return &biski64_kernel_tables[chosen];
+}
+#endif // BISKI64_X86_SIMD
+
+
+/**
+ * @internal
+ * @brief Returns the kernel table bound for this process, probing the CPU on first use.
+ *
+ * Concurrent first calls may each probe, but they all store the same pointer.
+ */
+static const biski64_kernel_table* biski64_kernels(void) {
+#ifdef BISKI64_X86_SIMD
+    static const biski64_kernel_table* bound = NULL;
+
+    const biski64_kernel_table* table = __atomic_load_n(&bound, __ATOMIC_ACQUIRE);
+    if (table == NULL) {
+        table = biski64_select_kernels();
+        __atomic_store_n(&bound, table, __ATOMIC_RELEASE);
+    }
+    return table;
+#else
+    return &biski64_kernel_tables[BISKI64_KERNEL_SCALAR];
+#endif
+}
+
+
+/**
+ * @brief Returns the instruction-set tier the bulk fill functions are bound to.
+ */
+static biski64_kernel biski64_kernel_in_use(void) {
+    return biski64_kernels()->kernel;
+}
+
+
+/**
+ * @brief Returns the name of the bound tier: "scalar", "avx2" or "avx512".
+ */
+static const char* biski64_kernel_name(void) {
+    return biski64_kernels()->name;
+}
+
+
+/**
+ * @brief Fills a buffer with pseudo-random numbers from a biski64x4 engine.
+ *
+ * Output element j comes from lane (j % 4). When n is not a multiple of 4, only the first
+ * (n % 4) lanes are advanced for the final partial step. No output is ever discarded, so
+ * across any sequence of calls lane k yields exactly the sequence of its scalar stream.
+ * The kernel is selected at runtime; see biski64_kernel_name().
+ *
+ * @param state Pointer to an initialized biski64x4_state structure.
+ * @param out   Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n     Number of 64-bit values to write.
+ */
+static void biski64x4_fill(biski64x4_state* state, uint64_t* out, size_t n) {
+    biski64_kernels()->fill_x4(state, out, n);
+}
+
+
+/**
+ * @brief Fills a buffer with pseudo-random numbers from a biski64x8 engine.
+ *
+ * Output element j comes from lane (j % 8). When n is not a multiple of 8, only the first
+ * (n % 8) lanes are advanced for the final partial step. No output is ever discarded, so
+ * across any sequence of calls lane k yields exactly the sequence of its scalar stream.
+ * The kernel is selected at runtime; see biski64_kernel_name().
+ *
+ * @param state Pointer to an initialized biski64x8_state structure.
+ * @param out   Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n     Number of 64-bit values to write.
+ */
+static void biski64x8_fill(biski64x8_state* state, uint64_t* out, size_t n) {
+    biski64_kernels()->fill_x8(state, out, n);
+}
+
+
+/**
+ * @brief Number of biski64_state generators interleaved by biski64_fill_u64().
+ *
+ * This is fixed, not a tuning knob: biski64_fill_u64() is unrolled by hand for four states, and
+ * with this count its output matches biski64x4_fill().
+ */
+#define BISKI64_FILL_LANES 4
+
+#if BISKI64_FILL_LANES != 4
+#error "biski64_fill_u64() is unrolled for exactly four lanes"
+#endif
+
+
+/**
+ * @brief Fills a buffer with pseudo-random numbers from several interleaved scalar generators.
+ *
+ * biski64_next() carries a serial dependency through `mix`, so a single generator leaves most
+ * ALU ports idle. This steps BISKI64_FILL_LANES independent generators per iteration, held in
+ * registers, which recovers most of the SIMD gain without intrinsics.
+ *
+ * Output element j comes from states[j % BISKI64_FILL_LANES]. When n is not a multiple of
+ * BISKI64_FILL_LANES, only the first (n % BISKI64_FILL_LANES) states are advanced for the
+ * final partial step, so no output is discarded and each state's sequence stays gap-free.
+ * With states[k] seeded by biski64_stream(seed, k, BISKI64_FILL_LANES), the output is
+ * identical to biski64x4_fill() on an engine seeded by biski64x4_seed(seed).
+ *
+ * @param states Array of BISKI64_FILL_LANES initialized biski64_state structures.
+ * The caller must ensure this pointer is not NULL.
+ * @param out    Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n      Number of 64-bit values to write.
+ */
+static void biski64_fill_u64(biski64_state* states, uint64_t* out, size_t n) {
+    uint64_t fast_loop0 = states[0].fast_loop, mix0 = states[0].mix, loop_mix0 = states[0].loop_mix;
+    uint64_t fast_loop1 = states[1].fast_loop, mix1 = states[1].mix, loop_mix1 = states[1].loop_mix;
+    uint64_t fast_loop2 = states[2].fast_loop, mix2 = states[2].mix, loop_mix2 = states[2].loop_mix;
+    uint64_t fast_loop3 = states[3].fast_loop, mix3 = states[3].mix, loop_mix3 = states[3].loop_mix;
+
+    const size_t full = n - n % BISKI64_FILL_LANES;
+
+    for (size_t i = 0; i < full; i += BISKI64_FILL_LANES) {
+        out[i + 0] = biski64_next_lane(&fast_loop0, &mix0, &loop_mix0);
+        out[i + 1] = biski64_next_lane(&fast_loop1, &mix1, &loop_mix1);
+        out[i + 2] = biski64_next_lane(&fast_loop2, &mix2, &loop_mix2);
+        out[i + 3] = biski64_next_lane(&fast_loop3, &mix3, &loop_mix3);
+    }
+
+    states[0].fast_loop = fast_loop0; states[0].mix = mix0; states[0].loop_mix = loop_mix0;
+    states[1].fast_loop = fast_loop1; states[1].mix = mix1; states[1].loop_mix = loop_mix1;
+    states[2].fast_loop = fast_loop2; states[2].mix = mix2; states[2].loop_mix = loop_mix2;
+    states[3].fast_loop = fast_loop3; states[3].mix = mix3; states[3].loop_mix = loop_mix3;
+
+    for (size_t k = 0; k < n % BISKI64_FILL_LANES; ++k)
+        out[full + k] = biski64_next(&states[k]);
+}
+
+
+/**
+ * @brief Buffers of at least this many bytes are filled with non-temporal stores by default.
+ */
+#define BISKI64_NONTEMPORAL_THRESHOLD_DEFAULT ((size_t)1 << 22)
+
+static size_t biski64_nontemporal_threshold = BISKI64_NONTEMPORAL_THRESHOLD_DEFAULT;
+
+
+/**
+ * @brief Sets the size at which biski64_fill_bytes() switches to non-temporal stores.
+ *
+ * Streaming stores bypass the cache hierarchy, so filling a multi-gigabyte buffer does not
+ * evict the working set from the LLC. Below the threshold regular stores are faster because
+ * the data is usually consumed while still cached. Pass SIZE_MAX to disable streaming stores.
+ * The setting is process-wide and is not synchronized; set it before starting worker threads.
+ *
+ * @param bytes The new threshold in bytes.
+ */
+static void biski64_set_nontemporal_threshold(size_t bytes) {
+    biski64_nontemporal_threshold = bytes;
+}
+
+
+/**
+ * @internal
+ * @brief Stores a 64-bit value in little-endian byte order.
+ */
+static inline void biski64_store_le64(uint8_t* p, uint64_t x) {
+    for (int b = 0; b < 8; ++b)
+        p[b] = (uint8_t)(x >> (8 * b));
+}
+
+
+#ifdef BISKI64_X86_SIMD
+/**
+ * @internal
+ * @brief Writes `words` generator outputs as little-endian bytes using non-temporal stores.
+ *
+ * Bytes up to the first 16-byte boundary are written normally. The aligned body is written
+ * with movntdq; when dest is not 8-byte aligned each store is funnel-shifted from two
+ * consecutive outputs, so the byte stream is identical to the cached path for any alignment.
+ */
+static void biski64_fill_words_nontemporal(biski64_state* state, uint8_t* p, size_t words) {
+    const size_t bytes = words * 8;
+    size_t head = (size_t)(-(uintptr_t)p & 15);
+    if (head > bytes)
+        head = bytes;
+
+    uint64_t carry = 0;  // Output bytes not yet written, lowest byte first.
+    unsigned carry_bytes = 0;
+
+    size_t i = 0;
+    for (; i < head; ++i) {
+        if (carry_bytes == 0) {
+            carry = biski64_next(state);
+            carry_bytes = 8;
+        }
+        p[i] = (uint8_t)carry;
+        carry >>= 8;
+        carry_bytes--;
+    }
+
+    const unsigned shift = 8 * carry_bytes;
+    const size_t body_end = i + (bytes - i) / 16 * 16;
+    for (; i < body_end; i += 16) {
+        uint64_t lo = biski64_next(state);
+        uint64_t hi = biski64_next(state);
+        if (shift != 0) {
+            const uint64_t next_carry = hi >> (64 - shift);
+            hi = (hi << shift) | (lo >> (64 - shift));
+            lo = (lo << shift) | carry;
+            carry = next_carry;
+        }
+        _mm_stream_si128((__m128i*)(p + i), _mm_set_epi64x((long long)hi, (long long)lo));
+    }
+    _mm_sfence();
+
+    for (; i < bytes; ++i) {
+        if (carry_bytes == 0) {
+            carry = biski64_next(state);
+            carry_bytes = 8;
+        }
+        p[i] = (uint8_t)carry;
+        carry >>= 8;
+        carry_bytes--;
+    }
+}
+#endif // BISKI64_X86_SIMD
+
+
+/**
+ * @brief Fills a byte buffer with pseudo-random data.
+ *
+ * Each full 8 bytes of dest receive the next output in little-endian order. A trailing
+ * 5..7 bytes take the low bytes of one more output, and a trailing 1..4 bytes take the
+ * high half of it, which matches Biski64Rng::fill_bytes() in the Rust crate.
+ * dest may have any alignment. Buffers of at least the non-temporal threshold (see
+ * biski64_set_nontemporal_threshold()) use streaming stores; the bytes produced are the same.
+ *
+ * @param state Pointer to an initialized biski64_state structure.
+ * @param dest  Destination buffer. The caller must ensure this is not NULL unless len is 0.
+ * @param len   Number of bytes to write.
+ */
+static void biski64_fill_bytes(biski64_state* state, void* dest, size_t len) {
+    uint8_t* p = (uint8_t*)dest;
+    const size_t words = len / 8;
+    const size_t tail = len % 8;
+
+#ifdef BISKI64_X86_SIMD
+    if (len >= biski64_nontemporal_threshold) {
+        biski64_fill_words_nontemporal(state, p, words);
+    } else
+#endif
+    {
+        for (size_t i = 0; i < words; ++i)
+            biski64_store_le64(p + 8 * i, biski64_next(state));
+    }
+
+    if (tail != 0) {
+        uint64_t last = biski64_next(state);
+        if (tail <= 4)
+            last >>= 32;
+        for (size_t b = 0; b < tail; ++b)
+            p[8 * words + b] = (uint8_t)(last >> (8 * b));
+    }
+}
+
+
+/**
+ * @brief Number of outputs cached by a biski64_buffered generator (2 KiB, L1-resident).
+ *
+ * Must be a multiple of 8 so the engine's lanes stay in lock-step across refills.
+ */
+#define BISKI64_BUFFER_SIZE 256
+
+
+/**
+ * @brief A biski64 generator that serves single values from a bulk-filled buffer.
+ *
+ * Wraps a biski64x8 engine (eight biski64_state lanes) and refills BISKI64_BUFFER_SIZE
+ * outputs at a time with one call to the vectorized biski64x8_fill(), so one-at-a-time
+ * callers get bulk-kernel throughput from the inline biski64_buffered_next().
+ *
+ * For a given seed the sequence is fixed and does not depend on the kernel in use: output i
+ * is value number (i / 8) of scalar stream biski64_stream(seed, i % 8, 8).
+ * This structure should be initialized via biski64_buffered_seed() or biski64_buffered_stream().
+ */
+typedef struct {
+    biski64x8_state engine;
+    size_t index;  // Next unread position in buffer; BISKI64_BUFFER_SIZE when empty.
+    uint64_t buffer[BISKI64_BUFFER_SIZE];
+} biski64_buffered;
+
+
+#ifndef BISKI64_DONT_USE_PARALLEL_STREAMS
+/**
+ * @brief Initializes a buffered generator for one of several parallel streams.
+ *
+ * The underlying engine is seeded with biski64x8_stream(), so streams never share lanes.
+ *
+ * @param gen Pointer to the biski64_buffered structure to be initialized.
+ * The caller must ensure this pointer is not NULL.
+ * @param seed The base 64-bit value shared by all streams.
+ * @param streamIndex The index of this generator (0 to totalNumStreams-1).
+ * @param totalNumStreams The total number of buffered generators sharing the seed.
+ */
+static void biski64_buffered_stream(biski64_buffered* gen, uint64_t seed, int streamIndex, int totalNumStreams) {
+    biski64x8_stream(&gen->engine, seed, streamIndex, totalNumStreams);
+    gen->index = BISKI64_BUFFER_SIZE;
+}
+
+
+/**
+ * @brief Initializes a buffered generator from a single 64-bit seed.
+ *
+ * @param gen  Pointer to the biski64_buffered structure to be initialized.
+ * @param seed The 64-bit value to use as the seed.
+ */
+static void biski64_buffered_seed(biski64_buffered* gen, uint64_t seed) {
+    biski64_buffered_stream(gen, seed, 0, 1);
+}
+#endif // BISKI64_DONT_USE_PARALLEL_STREAMS
+
+
+/**
+ * @internal
+ * @brief Refills the buffer of a buffered generator. Kept out of line so the fast path stays small.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline))
+#endif
+static void biski64_buffered_refill(biski64_buffered* gen) {
+    biski64x8_fill(&gen->engine, gen->buffer, BISKI64_BUFFER_SIZE);
+    gen->index = 0;
+}
+
+
+/**
+ * @brief Returns the next 64-bit pseudo-random number from a buffered generator.
+ *
+ * @param gen Pointer to an initialized biski64_buffered structure.
+ * @return A 64-bit pseudo-random unsigned integer.
+ */
+static inline uint64_t biski64_buffered_next(biski64_buffered* gen) {
+    if (gen->index == BISKI64_BUFFER_SIZE)
+        biski64_buffered_refill(gen);
+
+    return gen->buffer[gen->index++];
+}
+
+
+/**
+ * @brief A biski64 generator that serves two 32-bit values from each 64-bit step.
+ *
+ * biski64_next_u32() returns the low half of an output first and keeps the high half for
+ * the next call, so 32-bit draws cost half a generator step. The sequence is therefore
+ * the little-endian 32-bit view of the biski64_next() output stream, which is also what
+ * biski64_fill_u32() writes. This structure should be initialized via biski64_u32_seed()
+ * or biski64_u32_stream().
+ */
+typedef struct {
+    biski64_state state;
+    uint32_t spare;  // High half of the last output, valid when has_spare is non-zero.
+    int has_spare;
+} biski64_u32_state;
+
+
+/**
+ * @brief Initializes a 32-bit draw generator from a single 64-bit seed.
+ *
+ * The underlying state is seeded with biski64_seed().
+ *
+ * @param state Pointer to the biski64_u32_state structure to be initialized.
+ * @param seed  The 64-bit value to use as the seed.
+ */
+static void biski64_u32_seed(biski64_u32_state* state, uint64_t seed) {
+    biski64_seed(&state->state, seed);
+    state->spare = 0;
+    state->has_spare = 0;
+}
+
+
+#ifndef BISKI64_DONT_USE_PARALLEL_STREAMS
+/**
+ * @brief Initializes a 32-bit draw generator for one of several parallel streams.
+ *
+ * The underlying state is seeded with biski64_stream(); see that function for the parameters.
+ */
+static void biski64_u32_stream(biski64_u32_state* state, uint64_t seed, int streamIndex, int totalNumStreams) {
+    biski64_stream(&state->state, seed, streamIndex, totalNumStreams);
+    state->spare = 0;
+    state->has_spare = 0;
+}
+#endif // BISKI64_DONT_USE_PARALLEL_STREAMS
+
+
+/**
+ * @brief Returns the next 32-bit pseudo-random number, stepping the generator every other call.
+ *
+ * @param state Pointer to an initialized biski64_u32_state structure.
+ * @return A 32-bit pseudo-random unsigned integer.
+ */
+static inline uint32_t biski64_next_u32(biski64_u32_state* state) {
+    if (state->has_spare) {
+        state->has_spare = 0;
+        return state->spare;
+    }
+
+    const uint64_t output = biski64_next(&state->state);
+    state->spare = (uint32_t)(output >> 32);
+    state->has_spare = 1;
+    return (uint32_t)output;
+}
+
+
+/**
+ * @brief Fills a buffer with 32-bit pseudo-random numbers, two per generator step.
+ *
+ * Produces exactly the values n calls to biski64_next_u32() would, including a pending
+ * high half from an earlier call and leaving one pending when the count ends on a low half.
+ *
+ * @param state Pointer to an initialized biski64_u32_state structure.
+ * @param out   Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n     Number of 32-bit values to write.
+ */
+static void biski64_fill_u32(biski64_u32_state* state, uint32_t* out, size_t n) {
+    size_t i = 0;
+
+    if (n > 0 && state->has_spare) {
+        out[i++] = state->spare;
+        state->has_spare = 0;
+    }
+
+    for (; i + 2 <= n; i += 2) {
+        const uint64_t output = biski64_next(&state->state);
+        out[i]     = (uint32_t)output;
+        out[i + 1] = (uint32_t)(output >> 32);
+    }
+
+    if (i < n)
+        out[i] = biski64_next_u32(state);
+}
+
+
+/**
+ * @brief A biski64 generator that hands out random bits from a cached output.
+ *
+ * Bits are consumed least significant first, and a request that spans two outputs takes the
+ * remaining bits of the old output as its low bits. The bit sequence is therefore the
+ * concatenation of the biski64_next() outputs, each read from bit 0 up, regardless of how
+ * the requests are sized. This structure should be initialized via biski64_bits_seed() or
+ * biski64_bits_stream().
+ */
+typedef struct {
+    biski64_state state;
+    uint64_t bits;   // Unused bits, lowest first.
+    unsigned count;  // Number of unused bits, 0 to 64.
+} biski64_bits_state;
+
+
+/**
+ * @brief Initializes a bit reservoir from a single 64-bit seed.
+ *
+ * The underlying state is seeded with biski64_seed().
+ *
+ * @param state Pointer to the biski64_bits_state structure to be initialized.
+ * @param seed  The 64-bit value to use as the seed.
+ */
+static void biski64_bits_seed(biski64_bits_state* state, uint64_t seed) {
+    biski64_seed(&state->state, seed);
+    state->bits = 0;
+    state->count = 0;
+}
+
+
+#ifndef BISKI64_DONT_USE_PARALLEL_STREAMS
+/**
+ * @brief Initializes a bit reservoir for one of several parallel streams.
+ *
+ * The underlying state is seeded with biski64_stream(); see that function for the parameters.
+ */
+static void biski64_bits_stream(biski64_bits_state* state, uint64_t seed, int streamIndex, int totalNumStreams) {
+    biski64_stream(&state->state, seed, streamIndex, totalNumStreams);
+    state->bits = 0;
+    state->count = 0;
+}
+#endif // BISKI64_DONT_USE_PARALLEL_STREAMS
+
+
+/**
+ * @brief Returns k random bits in the low bits of the result.
+ *
+ * The common case is a mask, two shifts and one well-predicted branch; a new output is
+ * drawn only when fewer than k bits remain.
+ *
+ * @param state Pointer to an initialized biski64_bits_state structure.
+ * @param k Number of bits to return. The caller must ensure 1 <= k <= 64.
+ * @return A value in [0, 2^k).
+ */
+static inline uint64_t biski64_next_bits(biski64_bits_state* state, unsigned k) {
+    const uint64_t mask = ~0ULL >> (64 - k);
+
+    if (k <= state->count) {
+        const uint64_t result = state->bits & mask;
+        state->bits = (state->bits >> 1) >> (k - 1);  // Two shifts keep k = 64 defined.
+        state->count -= k;
+        return result;
+    }
+
+    const uint64_t output = biski64_next(&state->state);
+    const unsigned taken = k - state->count;  // Bits taken from the new output, 1 to 64.
+    const uint64_t result = (state->bits | (output << state->count)) & mask;
+
+    state->bits = (output >> 1) >> (taken - 1);
+    state->count = 64 - taken;
+    return result;
+}
+
+
+/**
+ * @brief Returns a random boolean (0 or 1), using one bit of a generator output.
+ *
+ * Equivalent to biski64_next_bits(state, 1), with a single branch taken once every 64 calls.
+ *
+ * @param state Pointer to an initialized biski64_bits_state structure.
+ * @return 0 or 1 with equal probability.
+ */
+static inline int biski64_next_bool(biski64_bits_state* state) {
+    if (state->count == 0) {
+        state->bits = biski64_next(&state->state);
+        state->count = 64;
+    }
+
+    const int result = (int)(state->bits & 1);
+    state->bits >>= 1;
+    state->count--;
+    return result;
+}
+
+
+/**
+ * @brief Fills a bitmap with nbits random bits using the vectorized biski64x8 engine.
+ *
+ * Bit i is bit (i % 64) of bitmap[i / 64], and the words are consecutive biski64x8_fill()
+ * outputs. Bits past nbits in the last word are cleared, so the bitmap can be counted or
+ * combined directly.
+ *
+ * @param state  Pointer to an initialized biski64x8_state structure.
+ * @param bitmap Destination with room for (nbits + 63) / 64 words. The caller must ensure
+ * this is not NULL unless nbits is 0.
+ * @param nbits  Number of random bits to write.
+ */
+static void biski64x8_fill_bits(biski64x8_state* state, uint64_t* bitmap, size_t nbits) {
+    const size_t words = (nbits + 63) / 64;
+
+    biski64x8_fill(state, bitmap, words);
+
+    if (nbits % 64 != 0)
+        bitmap[words - 1] &= ~0ULL >> (64 - nbits % 64);
+}
+
+
+/**
+ * @internal
+ * @brief Returns the high 64 bits of a * b and stores the low 64 bits in *lo.
+ */
+static inline uint64_t biski64_mul_hilo(uint64_t a, uint64_t b, uint64_t* lo) {
+#ifdef __SIZEOF_INT128__
+    const __uint128_t m = (__uint128_t)a * b;
+    *lo = (uint64_t)m;
+    return (uint64_t)(m >> 64);
+#else
+    const uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    const uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    const uint64_t p0 = a_lo * b_lo, p1 = a_lo * b_hi, p2 = a_hi * b_lo, p3 = a_hi * b_hi;
+    const uint64_t mid = (p0 >> 32) + (uint32_t)p1 + (uint32_t)p2;
+    *lo = (mid << 32) | (uint32_t)p0;
+    return p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+#endif
+}
+
+
+/**
+ * @brief Returns an unbiased pseudo-random integer in [0, range).
+ *
+ * Uses Lemire's nearly divisionless multiply-shift method: the high half of output * range
+ * is the result, and the low half decides rejection. The modulo that computes the exact
+ * rejection threshold only runs when the low half falls below range, which for small
+ * ranges is almost never.
+ *
+ * @param state Pointer to an initialized biski64_state structure.
+ * @param range The size of the interval. The caller must ensure range >= 1.
+ * @return A value in [0, range).
+ */
+static inline uint64_t biski64_bounded_u64(biski64_state* state, uint64_t range) {
+    uint64_t lo;
+    uint64_t hi = biski64_mul_hilo(biski64_next(state), range, &lo);
+
+    if (lo < range) {
+        const uint64_t threshold = (0 - range) % range;
+        while (lo < threshold)
+            hi = biski64_mul_hilo(biski64_next(state), range, &lo);
+    }
+
+    return hi;
+}
+
+
+/**
+ * @brief Returns an unbiased pseudo-random integer in [0, range) for a 32-bit range.
+ *
+ * Same method as biski64_bounded_u64(), using the high 32 bits of each output and a single
+ * 32x32-bit multiply.
+ *
+ * @param state Pointer to an initialized biski64_state structure.
+ * @param range The size of the interval. The caller must ensure range >= 1.
+ * @return A value in [0, range).
+ */
+static inline uint32_t biski64_bounded_u32(biski64_state* state, uint32_t range) {
+    uint64_t m = (biski64_next(state) >> 32) * range;
+
+    if ((uint32_t)m < range) {
+        const uint32_t threshold = (0 - range) % range;
+        while ((uint32_t)m < threshold)
+            m = (biski64_next(state) >> 32) * range;
+    }
+
+    return (uint32_t)(m >> 32);
+}
+
+
+/**
+ * @brief Number of engine outputs drawn per round by the batch functions built on biski64x8_fill().
+ */
+#define BISKI64_BATCH_CHUNK 128
+
+
+/**
+ * @internal
+ * @brief Maps raw outputs to 32-bit candidates and keeps the accepted ones, in order.
+ *
+ * Candidate 2j is the low half of raw[j] and candidate 2j+1 the high half. Every candidate
+ * is written and the write index only advances on acceptance, so there is no branch per
+ * element. accepted must have room for 2 * words values.
+ *
+ * @return The number of accepted values.
+ */
+static size_t biski64_bounded_compact_u32(const uint64_t* raw, size_t words, uint32_t range,
+                                          uint32_t threshold, uint32_t* accepted) {
+    size_t k = 0;
+
+    for (size_t j = 0; j < 2 * words; ++j) {
+        const uint64_t m = (uint64_t)(uint32_t)(raw[j / 2] >> (32 * (j & 1))) * range;
+        accepted[k] = (uint32_t)(m >> 32);
+        k += ((uint32_t)m >= threshold);
+    }
+
+    return k;
+}
+
+
+#ifdef BISKI64_X86_SIMD
+/**
+ * @internal
+ * @brief AVX-512 implementation of biski64_bounded_compact_u32().
+ *
+ * Multiplies sixteen candidates per iteration with two vpmuludq, interleaves the products
+ * back into candidate order, and packs the accepted results with vpcompressd. accepted must
+ * have room for 2 * words + 16 values, since each store writes a full vector.
+ * The caller must ensure the CPU supports AVX-512F.
+ */
+__attribute__((target("avx512f")))
+static size_t biski64_bounded_compact_u32_avx512(const uint64_t* raw, size_t words, uint32_t range,
+                                                 uint32_t threshold, uint32_t* accepted) {
+    const __m512i r         = _mm512_set1_epi64((long long)range);
+    const __m512i t         = _mm512_set1_epi32((int)threshold);
+    const __m512i high_mask = _mm512_set1_epi64((long long)0xFFFFFFFF00000000ULL);
+
+    size_t k = 0;
+    size_t j = 0;
+    for (; j + 8 <= words; j += 8) {
+        const __m512i x    = _mm512_loadu_si512(raw + j);
+        const __m512i even = _mm512_mul_epu32(x, r);                       // Low halves * range.
+        const __m512i odd  = _mm512_mul_epu32(_mm512_srli_epi64(x, 32), r);  // High halves * range.
+
+        const __m512i hi = _mm512_or_si512(_mm512_srli_epi64(even, 32), _mm512_and_si512(odd, high_mask));
+        const __m512i lo = _mm512_or_si512(_mm512_andnot_si512(high_mask, even), _mm512_slli_epi64(odd, 32));
+
+        const __mmask16 keep = _mm512_cmpge_epu32_mask(lo, t);
+        _mm512_storeu_si512(accepted + k, _mm512_maskz_compress_epi32(keep, hi));
+        k += (size_t)__builtin_popcount(keep);
+    }
+
+    return k + biski64_bounded_compact_u32(raw + j, words - j, range, threshold, accepted + k);
+}
+#endif // BISKI64_X86_SIMD
+
+
+/**
+ * @brief Fills an array with unbiased pseudo-random integers in [0, range) for a 32-bit range.
+ *
+ * Each round draws outputs from the biski64x8 engine, splits them into 32-bit candidates
+ * (low half first), and keeps the accepted ones in candidate order. The rejection threshold
+ * is computed once per call, and rejection is a compaction rather than a per-element branch;
+ * the AVX-512 tier does it with vpcompressd. Accepted values beyond n in the last round are
+ * discarded. The result depends only on the engine state, n and range, not on the kernel.
+ *
+ * @param state Pointer to an initialized biski64x8_state structure.
+ * @param out   Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n     Number of values to write.
+ * @param range The size of the interval. The caller must ensure range >= 1.
+ */
+static void biski64x8_fill_bounded_u32(biski64x8_state* state, uint32_t* out, size_t n, uint32_t range) {
+    const uint32_t threshold = (0 - range) % range;
+    uint64_t raw[BISKI64_BATCH_CHUNK];
+    uint32_t accepted[2 * BISKI64_BATCH_CHUNK + 16];
+
+    size_t filled = 0;
+    while (filled < n) {
+        size_t words = (n - filled + 1) / 2;
+        if (words > BISKI64_BATCH_CHUNK)
+            words = BISKI64_BATCH_CHUNK;
+
+        biski64x8_fill(state, raw, words);
+
+        size_t k;
+#ifdef BISKI64_X86_SIMD
+        if (biski64_kernel_in_use() == BISKI64_KERNEL_AVX512)
+            k = biski64_bounded_compact_u32_avx512(raw, words, range, threshold, accepted);
+        else
+#endif
+            k = biski64_bounded_compact_u32(raw, words, range, threshold, accepted);
+
+        if (k > n - filled)
+            k = n - filled;
+        memcpy(out + filled, accepted, k * sizeof(uint32_t));
+        filled += k;
+    }
+}
+
+
+/**
+ * @brief Fills an array with unbiased pseudo-random integers in [0, range) for a 64-bit range.
+ *
+ * Same structure as biski64x8_fill_bounded_u32(), with one candidate per output and a full
+ * 64x64-bit multiply per candidate (x86 vector units have no 64-bit high multiply, so the
+ * compaction runs on the scalar multiplier, still without a branch per element).
+ *
+ * @param state Pointer to an initialized biski64x8_state structure.
+ * @param out   Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n     Number of values to write.
+ * @param range The size of the interval. The caller must ensure range >= 1.
+ */
+static void biski64x8_fill_bounded_u64(biski64x8_state* state, uint64_t* out, size_t n, uint64_t range) {
+    const uint64_t threshold = (0 - range) % range;
+    uint64_t raw[BISKI64_BATCH_CHUNK];
+
+    size_t filled = 0;
+    while (filled < n) {
+        size_t words = n - filled;
+        if (words > BISKI64_BATCH_CHUNK)
+            words = BISKI64_BATCH_CHUNK;
+
+        biski64x8_fill(state, raw, words);
+
+        // Accepted values are compacted into raw in place; the write index never passes the read index.
+        size_t k = 0;
+        for (size_t j = 0; j < words; ++j) {
+            uint64_t lo;
+            raw[k] = biski64_mul_hilo(raw[j], range, &lo);
+            k += (lo >= threshold);
+        }
+
+        memcpy(out + filled, raw, k * sizeof(uint64_t));
+        filled += k;
+    }
+}
+
+
+/**
+ * @internal
+ * @brief Splits one output into count values by chained multiplication, rejecting if biased.
+ *
+ * Value i is the high half of x * ranges[i], and the low half becomes x for the next value.
+ * The final low half is uniform over [0, 2^64) and the draw is rejected when it falls below
+ * 2^64 mod product (Brackett-Rozinsky and Lemire, "Batched Ranged Random Integer
+ * Generation"), which leaves every tuple equally likely. When threshold is 0 it is computed
+ * on demand, so the division only runs when the final low half is below product.
+ */
+static inline void biski64_bounded_chain(biski64_state* state, const uint32_t* ranges, uint32_t range,
+                                         uint32_t* out, int count, uint64_t product, uint64_t threshold) {
+    for (;;) {
+        uint64_t x = biski64_next(state);
+        for (int i = 0; i < count; ++i) {
+            uint64_t lo;
+            out[i] = (uint32_t)biski64_mul_hilo(x, ranges != NULL ? ranges[i] : range, &lo);
+            x = lo;
+        }
+
+        if (x >= product)
+            return;
+        if (threshold == 0)
+            threshold = (0 - product) % product;
+        if (x >= threshold)
+            return;
+    }
+}
+
+
+/**
+ * @brief Draws several unbiased values with different small ranges from one output.
+ *
+ * out[i] is uniform in [0, ranges[i]) and the values are independent. A single generator
+ * step serves all of them unless the rare rejection case (probability below
+ * product / 2^64) requires another.
+ *
+ * @param state  Pointer to an initialized biski64_state structure.
+ * @param ranges The ranges. The caller must ensure each is >= 1 and that their product
+ * fits in 64 bits.
+ * @param out    Destination with room for count values.
+ * @param count  Number of values to draw.
+ */
+static void biski64_bounded_multi(biski64_state* state, const uint32_t* ranges, uint32_t* out, int count) {
+    uint64_t product = 1;
+    for (int i = 0; i < count; ++i)
+        product *= ranges[i];
+
+    biski64_bounded_chain(state, ranges, 0, out, count, product, 0);
+}
+
+
+/**
+ * @brief Draws count unbiased values in [0, range) from one output, e.g. several dice at once.
+ *
+ * @param state Pointer to an initialized biski64_state structure.
+ * @param range The size of the interval. The caller must ensure range >= 1 and that
+ * range^count is at most 2^64. At exactly 2^64 (e.g. 64 coin flips) product wraps to 0 and
+ * every draw is accepted.
+ * @param out   Destination with room for count values.
+ * @param count Number of values to draw.
+ */
+static void biski64_bounded_packed(biski64_state* state, uint32_t range, uint32_t* out, int count) {
+    uint64_t product = 1;
+    for (int i = 0; i < count; ++i)
+        product *= range;
+
+    biski64_bounded_chain(state, NULL, range, out, count, product, 0);
+}
+
+
+/**
+ * @brief Fills an array with unbiased values in [0, range), packing many per generator step.
+ *
+ * Each output is split into the largest k values whose product range^k stays at or below
+ * 2^48, which bounds the rejection probability per output by 2^-16: 18 dice rolls,
+ * 8 draws from 52 cards or 48 coin flips per step. The rejection threshold is computed once per call.
+ * Values from a final partial group that are not needed are discarded.
+ *
+ * @param state Pointer to an initialized biski64_state structure.
+ * @param out   Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n     Number of values to write.
+ * @param range The size of the interval. The caller must ensure range >= 1.
+ */
+static void biski64_fill_small_range(biski64_state* state, uint32_t* out, size_t n, uint32_t range) {
+    if (range == 1) {
+        memset(out, 0, n * sizeof(uint32_t));
+        return;
+    }
+
+    // range < 2^32 <= 2^48, so at least one value always fits.
+    int per_output = 0;
+    uint64_t product = 1;
+    while (product <= (1ULL << 48) / range) {
+        product *= range;
+        per_output++;
+    }
+    const uint64_t threshold = (0 - product) % product;
+
+    size_t i = 0;
+    for (; i + (size_t)per_output <= n; i += (size_t)per_output)
+        biski64_bounded_chain(state, NULL, range, out + i, per_output, product, threshold);
+
+    if (i < n) {
+        uint32_t group[64];
+        biski64_bounded_chain(state, NULL, range, group, per_output, product, threshold);
+        memcpy(out + i, group, (n - i) * sizeof(uint32_t));
+    }
+}
+
+
+/**
+ * @brief Fills an array with uniform doubles in [0, 1).
+ *
+ * Each double is built from one biski64x8 output by the exponent-bit trick: the top 52 bits
+ * become the mantissa of a value in [1, 2), and 1.0 is subtracted, giving multiples of 2^-52.
+ * Generation and conversion run in the same vector pass. Output order and tail handling
+ * follow biski64x8_fill(), and the values do not depend on the kernel in use.
+ *
+ * @param state Pointer to an initialized biski64x8_state structure.
+ * @param out   Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n     Number of values to write.
+ */
+static void biski64x8_fill_double(biski64x8_state* state, double* out, size_t n) {
+    biski64_kernels()->fill_double(state, out, n, 1.0);
+}
+
+
+/**
+ * @brief Fills an array with uniform doubles in the open interval (0, 1).
+ *
+ * Same as biski64x8_fill_double(), but subtracts 1 - 2^-53 instead of 1.0, which shifts the
+ * values to the odd multiples of 2^-53 in [2^-53, 1 - 2^-53]. The subtraction is exact, and
+ * the result is symmetric about 1/2, so log(u) and log(1 - u) are always finite.
+ *
+ * @param state Pointer to an initialized biski64x8_state structure.
+ * @param out   Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n     Number of values to write.
+ */
+static void biski64x8_fill_double_open(biski64x8_state* state, double* out, size_t n) {
+    biski64_kernels()->fill_double(state, out, n, 1.0 - 0x1p-53);
+}
+
+
+/**
+ * @brief Fills an array with uniform floats in [0, 1).
+ *
+ * Each output yields two floats, from its low and then its high 32 bits; the top 23 bits of
+ * each half become the mantissa, giving multiples of 2^-23. Steps are laid out as in
+ * biski64x8_fill() with each output expanded to two floats; for an odd n the high half of
+ * the last output is discarded.
+ *
+ * @param state Pointer to an initialized biski64x8_state structure.
+ * @param out   Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n     Number of values to write.
+ */
+static void biski64x8_fill_float(biski64x8_state* state, float* out, size_t n) {
+    biski64_kernels()->fill_float(state, out, n, 1.0f);
+}
+
+
+/**
+ * @brief Fills an array with uniform floats in the open interval (0, 1).
+ *
+ * Same as biski64x8_fill_float(), giving the odd multiples of 2^-24 in [2^-24, 1 - 2^-24].
+ *
+ * @param state Pointer to an initialized biski64x8_state structure.
+ * @param out   Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n     Number of values to write.
+ */
+static void biski64x8_fill_float_open(biski64x8_state* state, float* out, size_t n) {
+    biski64_kernels()->fill_float(state, out, n, 1.0f - 0x1p-24f);
+}
+
+
+/**
+ * @internal
+ * @brief Returns the number of leading zero bits of a non-zero 64-bit value.
+ */
+static inline unsigned biski64_clz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_clzll(x);
+#else
+    unsigned n = 0;
+    while (!(x & 0x8000000000000000ULL)) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+
+/**
+ * @internal
+ * @brief Returns the number of trailing zero bits of a non-zero 64-bit value.
+ */
+static inline unsigned biski64_ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(x);
+#else
+    unsigned n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+
+/**
+ * @internal
+ * @brief Continues a geometric leading-zero count with further outputs of one generator.
+ *
+ * Only reached when all exponent bits of the first output are zero. Stops as soon as
+ * limit zeros have been counted, since every deeper binade is the subnormal range.
+ */
+static unsigned biski64_dense_extra_zeros(uint64_t* fast_loop, uint64_t* mix, uint64_t* loop_mix, unsigned limit) {
+    unsigned zeros = 0;
+
+    while (zeros < limit) {
+        const uint64_t x = biski64_next_lane(fast_loop, mix, loop_mix);
+        if (x != 0)
+            return zeros + biski64_clz64(x);
+        zeros += 64;
+    }
+
+    return zeros;
+}
+
+
+/**
+ * @internal
+ * @brief Maps one output to a dense double in [0, 1), drawing from the given generator only
+ * when the top 12 bits are all zero.
+ *
+ * The low 52 bits are the mantissa. The leading zeros z of the output select the binade
+ * [2^-(z+1), 2^-z) with probability 2^-(z+1), continuing into further outputs past 12 zeros,
+ * and from 1022 zeros on the mantissa is used as a subnormal.
+ */
+static inline double biski64_dense_double(uint64_t x, uint64_t* fast_loop, uint64_t* mix, uint64_t* loop_mix) {
+    const uint64_t mantissa = x & 0x000FFFFFFFFFFFFFULL;
+    const unsigned zeros = (x >> 52) != 0 ? biski64_clz64(x)
+                                          : 12 + biski64_dense_extra_zeros(fast_loop, mix, loop_mix, 1022 - 12);
+
+    const uint64_t bits = zeros >= 1022 ? mantissa : ((uint64_t)(1022 - zeros) << 52) | mantissa;
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+
+/**
+ * @internal
+ * @brief Float counterpart of biski64_dense_double(): 23 mantissa bits and up to 41 exponent
+ * bits from the first output, subnormal from 126 zeros on.
+ */
+static inline float biski64_dense_float(uint64_t x, uint64_t* fast_loop, uint64_t* mix, uint64_t* loop_mix) {
+    const uint32_t mantissa = (uint32_t)x & 0x007FFFFFU;
+    const unsigned zeros = (x >> 23) != 0 ? biski64_clz64(x)
+                                          : 41 + biski64_dense_extra_zeros(fast_loop, mix, loop_mix, 126 - 41);
+
+    const uint32_t bits = zeros >= 126 ? mantissa : ((uint32_t)(126 - zeros) << 23) | mantissa;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+
+/**
+ * @brief Returns a double in [0, 1) where every representable value can appear.
+ *
+ * The usual 53-bit method only produces multiples of 2^-53, so values below 2^-53 never
+ * appear and small values are coarsely spaced. Here the exponent is drawn geometrically from
+ * leading zeros and the mantissa fills all 52 bits at every scale: each double d in [0, 1)
+ * is returned with probability equal to the gap to the next double, i.e. a uniform real
+ * rounded down. One output suffices unless its top 12 bits are zero (probability 2^-12).
+ *
+ * @param state Pointer to an initialized biski64_state structure.
+ * @return A double in [0, 1).
+ */
+static inline double biski64_next_double_dense(biski64_state* state) {
+    return biski64_dense_double(biski64_next(state), &state->fast_loop, &state->mix, &state->loop_mix);
+}
+
+
+/**
+ * @brief Returns a float in [0, 1) where every representable value can appear.
+ *
+ * Same method as biski64_next_double_dense(); a second output is needed with probability 2^-41.
+ *
+ * @param state Pointer to an initialized biski64_state structure.
+ * @return A float in [0, 1).
+ */
+static inline float biski64_next_float_dense(biski64_state* state) {
+    return biski64_dense_float(biski64_next(state), &state->fast_loop, &state->mix, &state->loop_mix);
+}
+
+
+/**
+ * @brief Fills an array with dense doubles in [0, 1), as biski64_next_double_dense().
+ *
+ * Value i is built from output i of biski64x8_fill(); the rare extra outputs for the
+ * exponent come from lane 0 of the engine, in order, so the result does not depend on
+ * the kernel in use.
+ *
+ * @param state Pointer to an initialized biski64x8_state structure.
+ * @param out   Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n     Number of values to write.
+ */
+static void biski64x8_fill_double_dense(biski64x8_state* state, double* out, size_t n) {
+    uint64_t raw[BISKI64_BATCH_CHUNK];
+
+    for (size_t done = 0; done < n; ) {
+        const size_t m = (n - done < BISKI64_BATCH_CHUNK) ? n - done : BISKI64_BATCH_CHUNK;
+        biski64x8_fill(state, raw, m);
+
+        for (size_t j = 0; j < m; ++j)
+            out[done + j] = biski64_dense_double(raw[j], &state->fast_loop[0], &state->mix[0], &state->loop_mix[0]);
+        done += m;
+    }
+}
+
+
+/**
+ * @brief Fills an array with dense floats in [0, 1), as biski64_next_float_dense().
+ *
+ * Value i is built from output i of biski64x8_fill(), with extra outputs from lane 0.
+ *
+ * @param state Pointer to an initialized biski64x8_state structure.
+ * @param out   Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n     Number of values to write.
+ */
+static void biski64x8_fill_float_dense(biski64x8_state* state, float* out, size_t n) {
+    uint64_t raw[BISKI64_BATCH_CHUNK];
+
+    for (size_t done = 0; done < n; ) {
+        const size_t m = (n - done < BISKI64_BATCH_CHUNK) ? n - done : BISKI64_BATCH_CHUNK;
+        biski64x8_fill(state, raw, m);
+
+        for (size_t j = 0; j < m; ++j)
+            out[done + j] = biski64_dense_float(raw[j], &state->fast_loop[0], &state->mix[0], &state->loop_mix[0]);
+        done += m;
+    }
+}
+
+
+#endif // BISKI64_C
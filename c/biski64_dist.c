@@ -0,0 +1,2285 @@
+#ifndef BISKI64_DIST_C
+#define BISKI64_DIST_C
+
+#include <math.h>   // For exp, expm1, log, log1p, lgamma, floor, frexp, fabs, fma, sqrt, pow, INFINITY
+
+// Unity build
+#include "biski64.c"
+#include "biski64_ziggurat_tables.h"
+
+// Non-uniform distributions driven by the biski64 generators.
+// Link with -lm.
+
+
+/**
+ * @internal
+ * @brief Start of the normal ziggurat's tail, equal to biski64_zig_norm_x[1].
+ */
+#define BISKI64_ZIG_NORM_R 3.6541528853610088
+
+
+/**
+ * @internal
+ * @brief Returns a double in the open interval (0, 1), safe to pass to log().
+ */
+static inline double biski64_next_open01(biski64_state* state) {
+    return biski64_to_double(biski64_next(state), 1.0 - 0x1p-53);
+}
+
+
+/**
+ * @internal
+ * @brief Returns a double uniform in [0, 1).
+ */
+static inline double biski64_next_unit(biski64_state* state) {
+    return biski64_to_double(biski64_next(state), 1.0);
+}
+
+
+/**
+ * @internal
+ * @brief Splits one output into a ziggurat candidate for the normal distribution.
+ *
+ * The low 8 bits select the layer and the top 52 bits give u in [-1, 1), which carries the
+ * sign. The candidate is u times the layer width; *layer receives the layer index.
+ */
+static inline double biski64_normal_candidate(uint64_t bits, unsigned* layer) {
+    *layer = (unsigned)(bits & 0xFF);
+    return 2.0 * biski64_to_double(bits, 1.5) * biski64_zig_norm_x[*layer];
+}
+
+
+/**
+ * @internal
+ * @brief Completes a normal draw from a first output, taking any further randomness from state.
+ *
+ * Returns the candidate straight away in the common case (about 99% of draws). Otherwise
+ * tests the wedge of the layer against the density, samples the tail beyond R for layer 0
+ * (Marsaglia's method), or starts over with a new output.
+ */
+static double biski64_normal_from(uint64_t bits, biski64_state* state) {
+    for (;;) {
+        unsigned i;
+        const double x = biski64_normal_candidate(bits, &i);
+
+        if (fabs(x) < biski64_zig_norm_x[i + 1])
+            return x;
+
+        if (i == 0) {
+            double a, b;
+            do {
+                a = -log(biski64_next_open01(state)) / BISKI64_ZIG_NORM_R;
+                b = -log(biski64_next_open01(state));
+            } while (b + b < a * a);
+            return x < 0 ? -(BISKI64_ZIG_NORM_R + a) : BISKI64_ZIG_NORM_R + a;
+        }
+
+        const double y = biski64_to_double(biski64_next(state), 1.0);
+        if (biski64_zig_norm_f[i + 1] + (biski64_zig_norm_f[i] - biski64_zig_norm_f[i + 1]) * y < exp(-0.5 * x * x))
+            return x;
+
+        bits = biski64_next(state);
+    }
+}
+
+
+/**
+ * @brief Returns a standard normal variate using a 256-layer ziggurat.
+ *
+ * The layer index, sign and mantissa all come from a single output, so the common case
+ * costs one generator step, a table lookup, a multiply and a compare.
+ *
+ * @param state Pointer to an initialized biski64_state structure.
+ * @return A normally distributed double with mean 0 and standard deviation 1.
+ */
+static inline double biski64_normal(biski64_state* state) {
+    return biski64_normal_from(biski64_next(state), state);
+}
+
+
+/**
+ * @internal
+ * @brief Start of the exponential ziggurat's tail, equal to biski64_zig_exp_x[1].
+ */
+#define BISKI64_ZIG_EXP_R 7.69711747013104972
+
+
+/**
+ * @internal
+ * @brief Completes an exponential draw from a first output, taking any further randomness from state.
+ *
+ * The low 8 bits select the layer and the top 52 bits the position within it; bits 8..11 are
+ * left free. Layer 0 beyond R uses the memoryless property: the tail is R plus a fresh draw.
+ */
+static double biski64_exponential_from(uint64_t bits, biski64_state* state) {
+    double shift = 0.0;
+    for (;;) {
+        const unsigned i = (unsigned)(bits & 0xFF);
+        const double x = biski64_to_double(bits, 1.0) * biski64_zig_exp_x[i];
+
+        if (x < biski64_zig_exp_x[i + 1])
+            return shift + x;
+
+        if (i == 0) {
+            shift += BISKI64_ZIG_EXP_R;
+        } else {
+            const double y = biski64_to_double(biski64_next(state), 1.0);
+            if (biski64_zig_exp_f[i + 1] + (biski64_zig_exp_f[i] - biski64_zig_exp_f[i + 1]) * y < exp(-x))
+                return shift + x;
+        }
+
+        bits = biski64_next(state);
+    }
+}
+
+
+/**
+ * @brief Returns a standard exponential variate (rate 1) using a 256-layer ziggurat.
+ *
+ * @param state Pointer to an initialized biski64_state structure.
+ * @return An exponentially distributed double with mean 1.
+ */
+static inline double biski64_exponential(biski64_state* state) {
+    return biski64_exponential_from(biski64_next(state), state);
+}
+
+
+/**
+ * @brief Returns a Laplace (double exponential) variate.
+ *
+ * The sign comes from bit 8 of the first output, which the exponential ziggurat leaves unused,
+ * so the common case still costs a single generator step.
+ *
+ * @param state    Pointer to an initialized biski64_state structure.
+ * @param location Centre of the distribution.
+ * @param scale    Scale b of the distribution; the variance is 2 b^2.
+ * @return A Laplace-distributed double.
+ */
+static inline double biski64_laplace(biski64_state* state, double location, double scale) {
+    const uint64_t bits = biski64_next(state);
+    const double e = biski64_exponential_from(bits, state);
+    return location + ((bits >> 8) & 1 ? -scale : scale) * e;
+}
+
+
+/**
+ * @internal
+ * @brief The distributions that share the batch ziggurat driver.
+ */
+typedef enum {
+    BISKI64_ZIG_NORMAL,
+    BISKI64_ZIG_EXPONENTIAL,
+    BISKI64_ZIG_LAPLACE
+} biski64_zig_kind;
+
+
+/**
+ * @internal
+ * @brief Computes ziggurat candidates scale * (u - offset) * x[layer] for raw[start..start + count),
+ * where u in [1, 2) is built from the top 52 bits, and marks the ones that need the slow path in
+ * the rejects bitmap (bit j of rejects[j / 64]). rejects must be zeroed by the caller.
+ */
+static void biski64_zig_candidates(const double* x_tab, double offset, double scale,
+                                   const uint64_t* raw, size_t start, size_t count, double* candidate, uint64_t* rejects) {
+    for (size_t k = 0; k < count; ++k) {
+        const size_t j = start + k;
+        const unsigned i = (unsigned)(raw[j] & 0xFF);
+        candidate[j] = scale * biski64_to_double(raw[j], offset) * x_tab[i];
+        rejects[j / 64] |= (uint64_t)!(fabs(candidate[j]) < x_tab[i + 1]) << (j % 64);
+    }
+}
+
+
+#ifdef BISKI64_X86_SIMD
+/**
+ * @internal
+ * @brief AVX2 implementation of biski64_zig_candidates() for four outputs at a time,
+ * with the layer widths fetched by vgatherqpd.
+ * The caller must ensure the CPU supports AVX2.
+ */
+__attribute__((target("avx2")))
+static void biski64_zig_candidates_avx2(const double* x_tab, double offset, double scale,
+                                        const uint64_t* raw, size_t m, double* candidate, uint64_t* rejects) {
+    const __m256i layer_mask = _mm256_set1_epi64x(0xFF);
+    const __m256i exponent   = _mm256_set1_epi64x(0x3FF0000000000000LL);
+    const __m256d off        = _mm256_set1_pd(offset);
+    const __m256d mul        = _mm256_set1_pd(scale);
+    const __m256d abs_mask   = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+
+    size_t j = 0;
+    for (; j + 4 <= m; j += 4) {
+        const __m256i bits  = _mm256_loadu_si256((const __m256i*)(raw + j));
+        const __m256i layer = _mm256_and_si256(bits, layer_mask);
+        const __m256d d     = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(bits, 12), exponent)), off);
+        const __m256d width = _mm256_i64gather_pd(x_tab, layer, 8);
+        const __m256d inner = _mm256_i64gather_pd(x_tab + 1, layer, 8);
+
+        const __m256d x = _mm256_mul_pd(_mm256_mul_pd(mul, d), width);
+        const __m256d reject = _mm256_cmp_pd(_mm256_and_pd(x, abs_mask), inner, _CMP_NLT_US);
+
+        _mm256_storeu_pd(candidate + j, x);
+        rejects[j / 64] |= (uint64_t)_mm256_movemask_pd(reject) << (j % 64);
+    }
+
+    biski64_zig_candidates(x_tab, offset, scale, raw, j, m - j, candidate, rejects);
+}
+
+
+/**
+ * @internal
+ * @brief AVX-512 implementation of biski64_zig_candidates() for eight outputs at a time.
+ * The caller must ensure the CPU supports AVX-512F.
+ */
+__attribute__((target("avx512f")))
+static void biski64_zig_candidates_avx512(const double* x_tab, double offset, double scale,
+                                          const uint64_t* raw, size_t m, double* candidate, uint64_t* rejects) {
+    const __m512i layer_mask = _mm512_set1_epi64(0xFF);
+    const __m512i exponent   = _mm512_set1_epi64(0x3FF0000000000000LL);
+    const __m512d off        = _mm512_set1_pd(offset);
+    const __m512d mul        = _mm512_set1_pd(scale);
+
+    size_t j = 0;
+    for (; j + 8 <= m; j += 8) {
+        const __m512i bits  = _mm512_loadu_si512(raw + j);
+        const __m512i layer = _mm512_and_si512(bits, layer_mask);
+        const __m512d d     = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(bits, 12), exponent)), off);
+        const __m512d width = _mm512_i64gather_pd(layer, x_tab, 8);
+        const __m512d inner = _mm512_i64gather_pd(layer, x_tab + 1, 8);
+
+        const __m512d x = _mm512_mul_pd(_mm512_mul_pd(mul, d), width);
+        const __mmask8 reject = _mm512_cmp_pd_mask(_mm512_abs_pd(x), inner, _CMP_NLT_US);
+
+        _mm512_storeu_pd(candidate + j, x);
+        rejects[j / 64] |= (uint64_t)reject << (j % 64);
+    }
+
+    biski64_zig_candidates(x_tab, offset, scale, raw, j, m - j, candidate, rejects);
+}
+#endif // BISKI64_X86_SIMD
+
+
+/**
+ * @internal
+ * @brief Shared batch driver for the ziggurat samplers; writes location + scale * z.
+ *
+ * Each round draws outputs with biski64x8_fill() and computes every ziggurat candidate in a
+ * vector pass (gathering layer widths on the AVX2 and AVX-512 tiers). The few candidates that
+ * fall outside their layer's inner rectangle are then completed in order by the scalar slow
+ * path, which draws its extra outputs from lane 0 of the engine. Value j is therefore a pure
+ * function of the engine state and n, independent of the kernel in use.
+ */
+static void biski64x8_fill_ziggurat(biski64x8_state* state, biski64_zig_kind kind, double* out, size_t n,
+                                    double location, double scale) {
+    const double* x_tab = (kind == BISKI64_ZIG_NORMAL) ? biski64_zig_norm_x : biski64_zig_exp_x;
+    const double offset = (kind == BISKI64_ZIG_NORMAL) ? 1.5 : 1.0;
+    const double mul    = (kind == BISKI64_ZIG_NORMAL) ? 2.0 : 1.0;
+
+    uint64_t raw[BISKI64_BATCH_CHUNK];
+    double candidate[BISKI64_BATCH_CHUNK];
+    uint64_t rejects[BISKI64_BATCH_CHUNK / 64];
+
+    for (size_t done = 0; done < n; ) {
+        const size_t m = (n - done < BISKI64_BATCH_CHUNK) ? n - done : BISKI64_BATCH_CHUNK;
+        biski64x8_fill(state, raw, m);
+
+        memset(rejects, 0, sizeof(rejects));
+#ifdef BISKI64_X86_SIMD
+        if (biski64_kernel_in_use() == BISKI64_KERNEL_AVX512)
+            biski64_zig_candidates_avx512(x_tab, offset, mul, raw, m, candidate, rejects);
+        else if (biski64_kernel_in_use() == BISKI64_KERNEL_AVX2)
+            biski64_zig_candidates_avx2(x_tab, offset, mul, raw, m, candidate, rejects);
+        else
+#endif
+            biski64_zig_candidates(x_tab, offset, mul, raw, 0, m, candidate, rejects);
+
+        double* dst = out + done;
+        if (kind == BISKI64_ZIG_LAPLACE) {
+            // Bit 8 of the output becomes the sign bit.
+            for (size_t j = 0; j < m; ++j) {
+                uint64_t z_bits;
+                memcpy(&z_bits, &candidate[j], sizeof(z_bits));
+                z_bits ^= (raw[j] << 55) & 0x8000000000000000ULL;
+                double z;
+                memcpy(&z, &z_bits, sizeof(z));
+                dst[j] = location + scale * z;
+            }
+        } else {
+            for (size_t j = 0; j < m; ++j)
+                dst[j] = location + scale * candidate[j];
+        }
+
+        // Redo the rejected entries, in order, with the scalar slow path.
+        biski64_state lane = biski64x8_get_lane(state, 0);
+        for (size_t w = 0; w < (m + 63) / 64; ++w) {
+            for (uint64_t pending = rejects[w]; pending != 0; pending &= pending - 1) {
+                const size_t j = w * 64 + biski64_ctz64(pending);
+                double z = (kind == BISKI64_ZIG_NORMAL) ? biski64_normal_from(raw[j], &lane) : biski64_exponential_from(raw[j], &lane);
+                if (kind == BISKI64_ZIG_LAPLACE && ((raw[j] >> 8) & 1))
+                    z = -z;
+                dst[j] = location + scale * z;
+            }
+        }
+        biski64x8_set_lane(state, 0, &lane);
+
+        done += m;
+    }
+}
+
+
+/**
+ * @brief Fills an array with normal variates with the given mean and standard deviation.
+ *
+ * Uses the same ziggurat as biski64_normal(), with the candidates for each chunk computed in
+ * one vector pass and the rare rejections finished by scalar code. The output does not
+ * depend on the kernel in use.
+ *
+ * @param state  Pointer to an initialized biski64x8_state structure.
+ * @param out    Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n      Number of values to write.
+ * @param mean   Mean of the distribution.
+ * @param stddev Standard deviation of the distribution.
+ */
+static void biski64x8_fill_normal(biski64x8_state* state, double* out, size_t n, double mean, double stddev) {
+    biski64x8_fill_ziggurat(state, BISKI64_ZIG_NORMAL, out, n, mean, stddev);
+}
+
+
+/**
+ * @brief Fills an array with exponential variates with the given rate.
+ *
+ * @param state Pointer to an initialized biski64x8_state structure.
+ * @param out   Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n     Number of values to write.
+ * @param rate  Rate lambda of the distribution; the mean is 1 / rate. Must be positive.
+ */
+static void biski64x8_fill_exponential(biski64x8_state* state, double* out, size_t n, double rate) {
+    biski64x8_fill_ziggurat(state, BISKI64_ZIG_EXPONENTIAL, out, n, 0.0, 1.0 / rate);
+}
+
+
+/**
+ * @brief Fills an array with Laplace variates, one output per value in the common case.
+ *
+ * @param state    Pointer to an initialized biski64x8_state structure.
+ * @param out      Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n        Number of values to write.
+ * @param location Centre of the distribution.
+ * @param scale    Scale b of the distribution; the variance is 2 b^2.
+ */
+static void biski64x8_fill_laplace(biski64x8_state* state, double* out, size_t n, double location, double scale) {
+    biski64x8_fill_ziggurat(state, BISKI64_ZIG_LAPLACE, out, n, location, scale);
+}
+
+
+/**
+ * @brief Precomputed constants for Gamma(shape, scale) sampling with Marsaglia and Tsang's method.
+ *
+ * Set up once with biski64_gamma_init() and reuse for every draw with the same parameters.
+ */
+typedef struct {
+    double d;         // shape - 1/3, or shape + 2/3 when shape < 1
+    double c;         // 1 / sqrt(9 d)
+    double inv_shape; // 1 / shape when shape < 1 (boosting), otherwise 0
+    double scale;
+} biski64_gamma_params;
+
+
+/**
+ * @brief Prepares the constants for drawing Gamma(shape, scale) variates.
+ *
+ * Shapes below 1 are handled by drawing Gamma(shape + 1) and multiplying by U^(1/shape).
+ *
+ * @param params Pointer to the structure to initialize.
+ * @param shape  Shape k of the distribution. Must be positive.
+ * @param scale  Scale theta of the distribution; the mean is k * theta.
+ */
+static void biski64_gamma_init(biski64_gamma_params* params, double shape, double scale) {
+    params->inv_shape = (shape < 1.0) ? 1.0 / shape : 0.0;
+    params->d = ((shape < 1.0) ? shape + 1.0 : shape) - 1.0 / 3.0;
+    params->c = 1.0 / sqrt(9.0 * params->d);
+    params->scale = scale;
+}
+
+
+/**
+ * @internal
+ * @brief Marsaglia-Tsang acceptance test for a normal x and uniform u in (0, 1).
+ * On acceptance writes the unscaled Gamma(d + 1/3) variate to *out and returns 1.
+ */
+static inline int biski64_gamma_accept(const biski64_gamma_params* params, double x, double u, double* out) {
+    double v = 1.0 + params->c * x;
+    if (v <= 0.0)
+        return 0;
+
+    v = v * v * v;
+    const double x2 = x * x;
+    if (u < 1.0 - 0.0331 * x2 * x2 || log(u) < 0.5 * x2 + params->d * (1.0 - v + log(v))) {
+        *out = params->d * v;
+        return 1;
+    }
+    return 0;
+}
+
+
+/**
+ * @internal
+ * @brief Draws an unscaled, unboosted Gamma(d + 1/3) variate, retrying until accepted.
+ */
+static double biski64_gamma_core(biski64_state* state, const biski64_gamma_params* params) {
+    for (;;) {
+        const double x = biski64_normal(state);
+        const double u = biski64_next_open01(state);
+        double g;
+        if (biski64_gamma_accept(params, x, u, &g))
+            return g;
+    }
+}
+
+
+/**
+ * @brief Returns a Gamma variate for precomputed parameters.
+ *
+ * Each attempt costs one ziggurat normal and one uniform; fewer than 5% of attempts are
+ * rejected for any shape, and the log test only runs when the cheap squeeze fails.
+ *
+ * @param state  Pointer to an initialized biski64_state structure.
+ * @param params Parameters prepared by biski64_gamma_init().
+ * @return A Gamma-distributed double.
+ */
+static inline double biski64_gamma_sample(biski64_state* state, const biski64_gamma_params* params) {
+    double g = biski64_gamma_core(state, params);
+    if (params->inv_shape != 0.0)
+        g *= pow(biski64_next_open01(state), params->inv_shape);
+    return g * params->scale;
+}
+
+
+/**
+ * @brief Returns a Gamma(shape, scale) variate. Prefer biski64_gamma_sample() when the
+ * parameters repeat.
+ */
+static inline double biski64_gamma(biski64_state* state, double shape, double scale) {
+    biski64_gamma_params params;
+    biski64_gamma_init(&params, shape, scale);
+    return biski64_gamma_sample(state, &params);
+}
+
+
+/**
+ * @brief Returns a Beta(alpha, beta) variate as X / (X + Y) with X ~ Gamma(alpha), Y ~ Gamma(beta).
+ */
+static inline double biski64_beta(biski64_state* state, double alpha, double beta) {
+    const double x = biski64_gamma(state, alpha, 1.0);
+    const double y = biski64_gamma(state, beta, 1.0);
+    return x / (x + y);
+}
+
+
+/**
+ * @brief Returns a chi-square variate with k degrees of freedom, i.e. Gamma(k / 2, 2).
+ */
+static inline double biski64_chi_square(biski64_state* state, double k) {
+    return biski64_gamma(state, 0.5 * k, 2.0);
+}
+
+
+/**
+ * @brief Returns a Student's t variate with nu degrees of freedom, Z / sqrt(V / nu) with V
+ * chi-square(nu).
+ */
+static inline double biski64_student_t(biski64_state* state, double nu) {
+    const double z = biski64_normal(state);
+    return z / sqrt(biski64_chi_square(state, nu) / nu);
+}
+
+
+/**
+ * @brief Draws one Dirichlet(alpha[0..k)) vector by normalizing independent Gamma(alpha[i]) draws.
+ *
+ * @param state Pointer to an initialized biski64_state structure.
+ * @param alpha Concentration parameters, all positive.
+ * @param k     Number of components.
+ * @param out   Destination for the k components, which sum to 1.
+ */
+static void biski64_dirichlet(biski64_state* state, const double* alpha, size_t k, double* out) {
+    double sum = 0.0;
+    for (size_t i = 0; i < k; ++i) {
+        out[i] = biski64_gamma(state, alpha[i], 1.0);
+        sum += out[i];
+    }
+    for (size_t i = 0; i < k; ++i)
+        out[i] /= sum;
+}
+
+
+/**
+ * @brief Fills an array with Gamma variates for fixed, precomputed parameters.
+ *
+ * Each chunk draws its normals with biski64x8_fill_normal() and its uniforms with
+ * biski64x8_fill_double_open(), then runs the acceptance test over the buffers. The few
+ * rejected entries are redrawn in order by the scalar sampler on lane 0 of the engine, so
+ * the output does not depend on the kernel in use.
+ *
+ * @param state  Pointer to an initialized biski64x8_state structure.
+ * @param params Parameters prepared by biski64_gamma_init().
+ * @param out    Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n      Number of values to write.
+ */
+static void biski64x8_fill_gamma(biski64x8_state* state, const biski64_gamma_params* params, double* out, size_t n) {
+    double normal[BISKI64_BATCH_CHUNK];
+    double uniform[BISKI64_BATCH_CHUNK];
+    double boost[BISKI64_BATCH_CHUNK];
+
+    for (size_t done = 0; done < n; ) {
+        const size_t m = (n - done < BISKI64_BATCH_CHUNK) ? n - done : BISKI64_BATCH_CHUNK;
+        double* dst = out + done;
+
+        biski64x8_fill_normal(state, normal, m, 0.0, 1.0);
+        biski64x8_fill_double_open(state, uniform, m);
+        if (params->inv_shape != 0.0)
+            biski64x8_fill_double_open(state, boost, m);
+
+        biski64_state lane = biski64x8_get_lane(state, 0);
+        for (size_t j = 0; j < m; ++j) {
+            if (!biski64_gamma_accept(params, normal[j], uniform[j], &dst[j]))
+                dst[j] = biski64_gamma_core(&lane, params);
+        }
+        biski64x8_set_lane(state, 0, &lane);
+
+        if (params->inv_shape != 0.0) {
+            for (size_t j = 0; j < m; ++j)
+                dst[j] *= pow(boost[j], params->inv_shape);
+        }
+        for (size_t j = 0; j < m; ++j)
+            dst[j] *= params->scale;
+
+        done += m;
+    }
+}
+
+
+/**
+ * @brief Fills an array with Beta(alpha, beta) variates.
+ */
+static void biski64x8_fill_beta(biski64x8_state* state, double alpha, double beta, double* out, size_t n) {
+    biski64_gamma_params pa, pb;
+    biski64_gamma_init(&pa, alpha, 1.0);
+    biski64_gamma_init(&pb, beta, 1.0);
+
+    double y[BISKI64_BATCH_CHUNK];
+    for (size_t done = 0; done < n; ) {
+        const size_t m = (n - done < BISKI64_BATCH_CHUNK) ? n - done : BISKI64_BATCH_CHUNK;
+        biski64x8_fill_gamma(state, &pa, out + done, m);
+        biski64x8_fill_gamma(state, &pb, y, m);
+        for (size_t j = 0; j < m; ++j)
+            out[done + j] /= out[done + j] + y[j];
+        done += m;
+    }
+}
+
+
+/**
+ * @brief Fills an array with chi-square variates with k degrees of freedom.
+ */
+static void biski64x8_fill_chi_square(biski64x8_state* state, double k, double* out, size_t n) {
+    biski64_gamma_params params;
+    biski64_gamma_init(&params, 0.5 * k, 2.0);
+    biski64x8_fill_gamma(state, &params, out, n);
+}
+
+
+/**
+ * @brief Fills an array with Student's t variates with nu degrees of freedom.
+ */
+static void biski64x8_fill_student_t(biski64x8_state* state, double nu, double* out, size_t n) {
+    biski64_gamma_params params;
+    biski64_gamma_init(&params, 0.5 * nu, 2.0 / nu);
+
+    double v[BISKI64_BATCH_CHUNK];
+    for (size_t done = 0; done < n; ) {
+        const size_t m = (n - done < BISKI64_BATCH_CHUNK) ? n - done : BISKI64_BATCH_CHUNK;
+        biski64x8_fill_normal(state, out + done, m, 0.0, 1.0);
+        biski64x8_fill_gamma(state, &params, v, m);
+        for (size_t j = 0; j < m; ++j)
+            out[done + j] /= sqrt(v[j]);
+        done += m;
+    }
+}
+
+
+/**
+ * @brief Fills count Dirichlet(alpha[0..k)) vectors, stored row by row in out.
+ *
+ * Components are drawn a column at a time with biski64x8_fill_gamma(), so each component's
+ * setup is computed once per chunk of rows rather than once per draw.
+ *
+ * @param state Pointer to an initialized biski64x8_state structure.
+ * @param alpha Concentration parameters, all positive.
+ * @param k     Number of components.
+ * @param out   Destination with room for count * k values; each row sums to 1.
+ * @param count Number of vectors to draw.
+ */
+static void biski64x8_fill_dirichlet(biski64x8_state* state, const double* alpha, size_t k, double* out, size_t count) {
+    double column[BISKI64_BATCH_CHUNK];
+    double sum[BISKI64_BATCH_CHUNK];
+
+    for (size_t done = 0; done < count; ) {
+        const size_t m = (count - done < BISKI64_BATCH_CHUNK) ? count - done : BISKI64_BATCH_CHUNK;
+        double* rows = out + done * k;
+
+        for (size_t r = 0; r < m; ++r)
+            sum[r] = 0.0;
+
+        for (size_t i = 0; i < k; ++i) {
+            biski64_gamma_params params;
+            biski64_gamma_init(&params, alpha[i], 1.0);
+            biski64x8_fill_gamma(state, &params, column, m);
+            for (size_t r = 0; r < m; ++r) {
+                rows[r * k + i] = column[r];
+                sum[r] += column[r];
+            }
+        }
+
+        for (size_t r = 0; r < m; ++r) {
+            const double inv = 1.0 / sum[r];
+            for (size_t i = 0; i < k; ++i)
+                rows[r * k + i] *= inv;
+        }
+
+        done += m;
+    }
+}
+
+
+/**
+ * @brief Precomputed constants for Poisson(mu) sampling.
+ *
+ * Means below 10 use inversion by sequential search from one uniform; larger means use
+ * Hormann's transformed rejection with squeeze (PTRS), which needs about 1.2 pairs of
+ * uniforms per variate whatever the mean.
+ */
+typedef struct {
+    double mu;
+    double exp_neg_mu;     // inversion: P(X = 0)
+    double log_mu;         // PTRS constants
+    double a, b;
+    double log_inv_alpha;
+    double v_r;
+    int use_inversion;
+} biski64_poisson_params;
+
+
+/**
+ * @brief Prepares the constants for drawing Poisson(mu) variates.
+ *
+ * @param params Pointer to the structure to initialize.
+ * @param mu     Mean of the distribution. Must be non-negative and finite.
+ */
+static void biski64_poisson_init(biski64_poisson_params* params, double mu) {
+    params->mu = mu;
+    params->use_inversion = (mu < 10.0);
+    params->exp_neg_mu = exp(-mu);
+
+    const double smu = sqrt(mu);
+    params->log_mu = log(mu);
+    params->b = 0.931 + 2.53 * smu;
+    params->a = -0.059 + 0.02483 * params->b;
+    params->log_inv_alpha = log(1.1239 + 1.1328 / (params->b - 3.4));
+    params->v_r = 0.9277 - 3.6224 / (params->b - 2.0);
+}
+
+
+/**
+ * @internal
+ * @brief Poisson inversion by sequential search for a uniform u in [0, 1).
+ */
+static inline uint64_t biski64_poisson_invert(const biski64_poisson_params* params, double u) {
+    double p = params->exp_neg_mu;
+    uint64_t k = 0;
+    while (u > p && p > 0.0) {
+        u -= p;
+        ++k;
+        p *= params->mu / (double)k;
+    }
+    return k;
+}
+
+
+/**
+ * @internal
+ * @brief One PTRS attempt from u in (-0.5, 0.5) and v in (0, 1).
+ * On acceptance writes the variate to *out and returns 1.
+ */
+static inline int biski64_ptrs_attempt(const biski64_poisson_params* params, double u, double v, uint64_t* out) {
+    const double us = 0.5 - fabs(u);
+    const double k = floor((2.0 * params->a / us + params->b) * u + params->mu + 0.43);
+
+    if (us >= 0.07 && v <= params->v_r) {
+        *out = (uint64_t)k;
+        return 1;
+    }
+    if (k < 0.0 || (us < 0.013 && v > us))
+        return 0;
+
+    if (log(v) + params->log_inv_alpha - log(params->a / (us * us) + params->b)
+            <= -params->mu + k * params->log_mu - lgamma(k + 1.0)) {
+        *out = (uint64_t)k;
+        return 1;
+    }
+    return 0;
+}
+
+
+/**
+ * @brief Returns a Poisson variate for precomputed parameters.
+ *
+ * @param state  Pointer to an initialized biski64_state structure.
+ * @param params Parameters prepared by biski64_poisson_init().
+ * @return A Poisson-distributed count.
+ */
+static uint64_t biski64_poisson_sample(biski64_state* state, const biski64_poisson_params* params) {
+    if (params->use_inversion)
+        return biski64_poisson_invert(params, biski64_next_unit(state));
+
+    for (;;) {
+        const double u = biski64_next_open01(state) - 0.5;
+        const double v = biski64_next_open01(state);
+        uint64_t k;
+        if (biski64_ptrs_attempt(params, u, v, &k))
+            return k;
+    }
+}
+
+
+/**
+ * @brief Returns a Poisson(mu) variate. Prefer biski64_poisson_sample() when mu repeats.
+ */
+static inline uint64_t biski64_poisson(biski64_state* state, double mu) {
+    biski64_poisson_params params;
+    biski64_poisson_init(&params, mu);
+    return biski64_poisson_sample(state, &params);
+}
+
+
+/**
+ * @brief Fills an array with Poisson variates for a fixed, precomputed mean.
+ *
+ * Uniforms for a chunk are drawn with biski64x8_fill_double() / biski64x8_fill_double_open().
+ * Rejected PTRS attempts are redrawn in order on lane 0 of the engine, so the output does
+ * not depend on the kernel in use.
+ *
+ * @param state  Pointer to an initialized biski64x8_state structure.
+ * @param params Parameters prepared by biski64_poisson_init().
+ * @param out    Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n      Number of values to write.
+ */
+static void biski64x8_fill_poisson(biski64x8_state* state, const biski64_poisson_params* params, uint64_t* out, size_t n) {
+    double u[BISKI64_BATCH_CHUNK];
+    double v[BISKI64_BATCH_CHUNK];
+
+    for (size_t done = 0; done < n; ) {
+        const size_t m = (n - done < BISKI64_BATCH_CHUNK) ? n - done : BISKI64_BATCH_CHUNK;
+        uint64_t* dst = out + done;
+
+        if (params->use_inversion) {
+            biski64x8_fill_double(state, u, m);
+            for (size_t j = 0; j < m; ++j)
+                dst[j] = biski64_poisson_invert(params, u[j]);
+        } else {
+            biski64x8_fill_double_open(state, u, m);
+            biski64x8_fill_double_open(state, v, m);
+
+            biski64_state lane = biski64x8_get_lane(state, 0);
+            for (size_t j = 0; j < m; ++j) {
+                if (!biski64_ptrs_attempt(params, u[j] - 0.5, v[j], &dst[j]))
+                    dst[j] = biski64_poisson_sample(&lane, params);
+            }
+            biski64x8_set_lane(state, 0, &lane);
+        }
+
+        done += m;
+    }
+}
+
+
+/**
+ * @brief Precomputed constants for Binomial(n, p) sampling.
+ *
+ * p is folded to min(p, 1 - p). When the mode is below 11 inversion by sequential search is
+ * used; otherwise Hormann's BTRD (transformed rejection with decomposition), whose expected
+ * cost is constant in n.
+ */
+typedef struct {
+    uint64_t n;
+    double p;              // min(p, 1 - p)
+    int flipped;           // 1 if the caller's p was above 1/2
+    int use_inversion;
+    double q_n;            // inversion: (1 - p)^n
+    double s, a_inv;       // inversion: p / q and (n + 1) p / q
+    double m, r, nr, npq;  // BTRD constants
+    double a, b, c;
+    double alpha, v_r, u_rv_r;
+} biski64_binomial_params;
+
+
+/**
+ * @brief Prepares the constants for drawing Binomial(n, p) variates.
+ *
+ * @param params Pointer to the structure to initialize.
+ * @param n      Number of trials.
+ * @param p      Success probability in [0, 1].
+ */
+static void biski64_binomial_init(biski64_binomial_params* params, uint64_t n, double p) {
+    params->n = n;
+    params->flipped = (p > 0.5);
+    params->p = params->flipped ? 1.0 - p : p;
+
+    const double q = 1.0 - params->p, t = (double)n;
+    params->m = floor((t + 1.0) * params->p);
+    params->use_inversion = (params->m < 11.0);
+
+    params->q_n = pow(q, t);
+    params->s = params->p / q;
+    params->a_inv = (t + 1.0) * params->s;
+
+    params->r = params->p / q;
+    params->nr = (t + 1.0) * params->r;
+    params->npq = t * params->p * q;
+    const double sqrt_npq = sqrt(params->npq);
+    params->b = 1.15 + 2.53 * sqrt_npq;
+    params->a = -0.0873 + 0.0248 * params->b + 0.01 * params->p;
+    params->c = t * params->p + 0.5;
+    params->alpha = (2.83 + 5.1 / params->b) * sqrt_npq;
+    params->v_r = 0.92 - 4.2 / params->b;
+    params->u_rv_r = 0.86 * params->v_r;
+}
+
+
+/**
+ * @internal
+ * @brief Binomial inversion by sequential search for a uniform u in [0, 1), using the folded p.
+ */
+static inline uint64_t biski64_binomial_invert(const biski64_binomial_params* params, double u) {
+    double r = params->q_n;
+    uint64_t x = 0;
+    while (u > r && x < params->n) {
+        u -= r;
+        ++x;
+        r *= params->a_inv / (double)x - params->s;
+    }
+    return x;
+}
+
+
+/**
+ * @internal
+ * @brief Stirling series correction log(k!) - [(k + 1/2) log(k + 1) - (k + 1) + log(sqrt(2 pi))].
+ */
+static inline double biski64_stirling_tail(double k) {
+    static const double small[10] = {
+        0.08106146679532726, 0.04134069595540929, 0.02767792568499834, 0.02079067210376509,
+        0.01664469118982119, 0.01387612882307075, 0.01189670994589177, 0.01041126526197209,
+        0.009255462182712733, 0.008330563433362871
+    };
+    if (k < 10.0)
+        return small[(int)k];
+
+    const double r = 1.0 / (k + 1.0), rr = r * r;
+    return (1.0 / 12.0 - (1.0 / 360.0 - rr / 1260.0) * rr) * r;
+}
+
+
+/**
+ * @internal
+ * @brief BTRD for the folded p, starting from a first uniform v in [0, 1) and taking any
+ * further uniforms from state.
+ */
+static double biski64_btrd_from(const biski64_binomial_params* params, double v, biski64_state* state) {
+    const double t = (double)params->n;
+    for (;; v = biski64_next_unit(state)) {
+        if (v <= params->u_rv_r) {
+            const double u = v / params->v_r - 0.43;
+            return floor((2.0 * params->a / (0.5 - fabs(u)) + params->b) * u + params->c);
+        }
+
+        double u;
+        if (v >= params->v_r) {
+            u = biski64_next_unit(state) - 0.5;
+        } else {
+            u = v / params->v_r - 0.93;
+            u = ((u < 0.0) ? -0.5 : 0.5) - u;
+            v = biski64_next_unit(state) * params->v_r;
+        }
+
+        const double us = 0.5 - fabs(u);
+        const double k = floor((2.0 * params->a / us + params->b) * u + params->c);
+        if (k < 0.0 || k > t)
+            continue;
+
+        v = v * params->alpha / (params->a / (us * us) + params->b);
+        const double km = fabs(k - params->m);
+
+        if (km <= 15.0) {
+            // Recursive evaluation of f(k) / f(m).
+            double f = 1.0;
+            if (params->m < k) {
+                for (double i = params->m + 1.0; i <= k; i += 1.0)
+                    f *= params->nr / i - params->r;
+            } else if (params->m > k) {
+                for (double i = k + 1.0; i <= params->m; i += 1.0)
+                    v *= params->nr / i - params->r;
+            }
+            if (v <= f)
+                return k;
+            continue;
+        }
+
+        // Squeeze on log(v), then the final test with Stirling corrections.
+        v = log(v);
+        const double rho = km / params->npq * (((km / 3.0 + 0.625) * km + 1.0 / 6.0) / params->npq + 0.5);
+        const double tt = -km * km / (2.0 * params->npq);
+        if (v < tt - rho)
+            return k;
+        if (v > tt + rho)
+            continue;
+
+        const double nm = t - params->m + 1.0;
+        const double h = (params->m + 0.5) * log((params->m + 1.0) / (params->r * nm))
+                       + biski64_stirling_tail(params->m) + biski64_stirling_tail(t - params->m);
+        const double nk = t - k + 1.0;
+        if (v <= h + (t + 1.0) * log(nm / nk) + (k + 0.5) * log(nk * params->r / (k + 1.0))
+                  - biski64_stirling_tail(k) - biski64_stirling_tail(t - k))
+            return k;
+    }
+}
+
+
+/**
+ * @internal
+ * @brief Completes a binomial draw from a first uniform v in [0, 1), undoing the p fold.
+ */
+static inline uint64_t biski64_binomial_from(const biski64_binomial_params* params, double v, biski64_state* state) {
+    const uint64_t k = params->use_inversion ? biski64_binomial_invert(params, v)
+                                             : (uint64_t)biski64_btrd_from(params, v, state);
+    return params->flipped ? params->n - k : k;
+}
+
+
+/**
+ * @brief Returns a binomial variate for precomputed parameters.
+ *
+ * @param state  Pointer to an initialized biski64_state structure.
+ * @param params Parameters prepared by biski64_binomial_init().
+ * @return The number of successes, in [0, n].
+ */
+static inline uint64_t biski64_binomial_sample(biski64_state* state, const biski64_binomial_params* params) {
+    return biski64_binomial_from(params, biski64_next_unit(state), state);
+}
+
+
+/**
+ * @brief Returns a Binomial(n, p) variate. Prefer biski64_binomial_sample() when n and p repeat.
+ */
+static inline uint64_t biski64_binomial(biski64_state* state, uint64_t n, double p) {
+    biski64_binomial_params params;
+    biski64_binomial_init(&params, n, p);
+    return biski64_binomial_sample(state, &params);
+}
+
+
+/**
+ * @brief Fills an array with binomial variates for fixed, precomputed parameters.
+ *
+ * The first uniform of every draw comes from biski64x8_fill_double(); about 80% of BTRD draws
+ * (and every inversion draw) need nothing else. The rest continue in order on lane 0 of the
+ * engine, so the output does not depend on the kernel in use.
+ *
+ * @param state  Pointer to an initialized biski64x8_state structure.
+ * @param params Parameters prepared by biski64_binomial_init().
+ * @param out    Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n      Number of values to write.
+ */
+static void biski64x8_fill_binomial(biski64x8_state* state, const biski64_binomial_params* params, uint64_t* out, size_t n) {
+    double v[BISKI64_BATCH_CHUNK];
+
+    for (size_t done = 0; done < n; ) {
+        const size_t m = (n - done < BISKI64_BATCH_CHUNK) ? n - done : BISKI64_BATCH_CHUNK;
+        biski64x8_fill_double(state, v, m);
+
+        biski64_state lane = biski64x8_get_lane(state, 0);
+        for (size_t j = 0; j < m; ++j)
+            out[done + j] = biski64_binomial_from(params, v[j], &lane);
+        biski64x8_set_lane(state, 0, &lane);
+
+        done += m;
+    }
+}
+
+
+/**
+ * @brief Draws a multinomial count vector as a chain of conditional binomials.
+ *
+ * Component i is Binomial(remaining trials, probs[i] / remaining mass), so the cost is k
+ * binomial draws regardless of the number of trials.
+ *
+ * @param state  Pointer to an initialized biski64_state structure.
+ * @param trials Total number of trials.
+ * @param probs  Category probabilities, non-negative and summing to 1.
+ * @param k      Number of categories.
+ * @param counts Destination for the k counts, which sum to trials.
+ */
+static void biski64_multinomial(biski64_state* state, uint64_t trials, const double* probs, size_t k, uint64_t* counts) {
+    uint64_t remaining = trials;
+    double mass = 1.0;
+
+    for (size_t i = 0; i + 1 < k; ++i) {
+        uint64_t c = 0;
+        if (remaining > 0 && probs[i] > 0.0) {
+            const double p = (probs[i] < mass) ? probs[i] / mass : 1.0;
+            c = biski64_binomial(state, remaining, p);
+        }
+        counts[i] = c;
+        remaining -= c;
+        mass -= probs[i];
+    }
+    if (k > 0)
+        counts[k - 1] = remaining;
+}
+
+
+/**
+ * @brief Precomputed constants for geometric sampling: the number of failures before the first
+ * success in Bernoulli(p) trials, P(X = k) = (1 - p)^k p.
+ */
+typedef struct {
+    double inv_log_q;  // 1 / log(1 - p), for inversion
+    unsigned shift;    // k when 1 - p == 2^-k exactly, otherwise 0
+} biski64_geometric_params;
+
+
+/**
+ * @brief Prepares the constants for geometric sampling with success probability p.
+ *
+ * When the failure probability 1 - p is exactly 2^-k (p = 1/2, 3/4, 7/8, ...), such as the
+ * promotion chain of a skip list with fan-out 2^k, draws count trailing zero bits instead
+ * of taking a logarithm.
+ *
+ * @param params Pointer to the structure to initialize.
+ * @param p      Success probability in [0, 1].
+ */
+static void biski64_geometric_init(biski64_geometric_params* params, double p) {
+    int e;
+    const double m = frexp(1.0 - p, &e);
+    params->shift = (m == 0.5 && e <= 0 && e >= -63) ? (unsigned)(1 - e) : 0;
+    params->inv_log_q = 1.0 / log1p(-p);
+}
+
+
+/**
+ * @internal
+ * @brief Converts a non-negative double count to uint64_t, saturating at UINT64_MAX.
+ */
+static inline uint64_t biski64_saturate_u64(double x) {
+    return (x < 0x1p64) ? (uint64_t)x : UINT64_MAX;
+}
+
+
+/**
+ * @internal
+ * @brief Geometric draw by inversion from u in (0, 1): floor(log(u) / log(1 - p)).
+ */
+static inline uint64_t biski64_geometric_invert(const biski64_geometric_params* params, double u) {
+    return biski64_saturate_u64(floor(log(u) * params->inv_log_q));
+}
+
+
+/**
+ * @internal
+ * @brief Power-of-two geometric draw: trailing zeros of the bit stream starting with bits,
+ * divided by the shift. Further outputs are taken from state only while bits are all zero.
+ */
+static inline uint64_t biski64_geometric_ctz(const biski64_geometric_params* params, uint64_t bits, biski64_state* state) {
+    uint64_t zeros = 0;
+    while (bits == 0) {
+        zeros += 64;
+        bits = biski64_next(state);
+    }
+    return (zeros + biski64_ctz64(bits)) / params->shift;
+}
+
+
+/**
+ * @brief Returns a geometric variate for precomputed parameters.
+ *
+ * @param state  Pointer to an initialized biski64_state structure.
+ * @param params Parameters prepared by biski64_geometric_init().
+ * @return The number of failures before the first success, saturated at UINT64_MAX.
+ */
+static inline uint64_t biski64_geometric_sample(biski64_state* state, const biski64_geometric_params* params) {
+    if (params->shift != 0)
+        return biski64_geometric_ctz(params, biski64_next(state), state);
+    return biski64_geometric_invert(params, biski64_next_open01(state));
+}
+
+
+/**
+ * @brief Returns a geometric variate with success probability p. Prefer
+ * biski64_geometric_sample() when p repeats.
+ */
+static inline uint64_t biski64_geometric(biski64_state* state, double p) {
+    biski64_geometric_params params;
+    biski64_geometric_init(&params, p);
+    return biski64_geometric_sample(state, &params);
+}
+
+
+/**
+ * @brief Fills an array with geometric variates for fixed, precomputed parameters.
+ *
+ * @param state  Pointer to an initialized biski64x8_state structure.
+ * @param params Parameters prepared by biski64_geometric_init().
+ * @param out    Destination buffer with room for n values. The caller must ensure this is not NULL.
+ * @param n      Number of values to write.
+ */
+static void biski64x8_fill_geometric(biski64x8_state* state, const biski64_geometric_params* params, uint64_t* out, size_t n) {
+    if (params->shift != 0) {
+        biski64x8_fill(state, out, n);
+
+        // An all-zero output (probability 2^-64) continues its run on lane 0.
+        biski64_state lane = biski64x8_get_lane(state, 0);
+        for (size_t j = 0; j < n; ++j)
+            out[j] = biski64_geometric_ctz(params, out[j], &lane);
+        biski64x8_set_lane(state, 0, &lane);
+        return;
+    }
+
+    double u[BISKI64_BATCH_CHUNK];
+    for (size_t done = 0; done < n; ) {
+        const size_t m = (n - done < BISKI64_BATCH_CHUNK) ? n - done : BISKI64_BATCH_CHUNK;
+        biski64x8_fill_double_open(state, u, m);
+        for (size_t j = 0; j < m; ++j)
+            out[done + j] = biski64_geometric_invert(params, u[j]);
+        done += m;
+    }
+}
+
+
+/**
+ * @brief Iterator over the indices selected by independent Bernoulli(p) trials.
+ *
+ * Rather than flipping a coin per row, each step jumps ahead by a geometric skip distance,
+ * so walking a column of any length costs O(selected rows).
+ */
+typedef struct {
+    biski64_geometric_params gap;
+    uint64_t next;
+} biski64_selector;
+
+
+/**
+ * @brief Starts a selector for sampling indices 0, 1, 2, ... at rate p.
+ *
+ * @param selector Pointer to the selector to initialize.
+ * @param state    Generator used for the first skip distance.
+ * @param p        Selection probability of each index, in [0, 1].
+ */
+static void biski64_selector_init(biski64_selector* selector, biski64_state* state, double p) {
+    biski64_geometric_init(&selector->gap, p);
+    selector->next = biski64_geometric_sample(state, &selector->gap);
+}
+
+
+/**
+ * @brief Returns the next selected index and draws the skip distance after it.
+ *
+ * Indices are strictly increasing; once they pass UINT64_MAX - 1 the selector stays at
+ * UINT64_MAX, which callers can treat as "no further selection".
+ *
+ * @param selector Pointer to an initialized biski64_selector.
+ * @param state    Generator used for the skip distances.
+ * @return The selected index.
+ */
+static inline uint64_t biski64_selector_next(biski64_selector* selector, biski64_state* state) {
+    const uint64_t index = selector->next;
+    const uint64_t gap = biski64_geometric_sample(state, &selector->gap);
+    selector->next = (index < UINT64_MAX - 1 && gap < UINT64_MAX - 1 - index) ? index + 1 + gap : UINT64_MAX;
+    return index;
+}
+
+
+/**
+ * @brief Writes the selected indices below limit into out, up to capacity of them.
+ *
+ * Call repeatedly with the same limit to drain a range in pieces; the selector resumes after
+ * the last index written.
+ *
+ * @param selector Pointer to an initialized biski64_selector.
+ * @param state    Generator used for the skip distances.
+ * @param limit    Exclusive upper bound of the indices to return.
+ * @param out      Destination for the indices.
+ * @param capacity Maximum number of indices to write.
+ * @return The number of indices written.
+ */
+static size_t biski64_selector_fill(biski64_selector* selector, biski64_state* state, uint64_t limit, uint64_t* out, size_t capacity) {
+    size_t count = 0;
+    while (count < capacity && selector->next < limit)
+        out[count++] = biski64_selector_next(selector, state);
+    return count;
+}
+
+
+/**
+ * @brief One column of an alias table: accept the column when the low half of the draw is
+ * below threshold, otherwise take alias. Both live in the same 8 bytes, so a sample touches
+ * one cache line.
+ */
+typedef struct {
+    uint32_t threshold;
+    uint32_t alias;
+} biski64_alias_entry;
+
+
+/**
+ * @brief Walker alias table for sampling from a fixed discrete distribution in O(1).
+ */
+typedef struct {
+    biski64_alias_entry* entries;
+    uint32_t n;
+} biski64_alias_table;
+
+
+/**
+ * @brief Builds an alias table for the given weights with Vose's O(n) method.
+ *
+ * Acceptance thresholds are stored with 32-bit resolution.
+ *
+ * @param table   Pointer to the table to initialize; release it with biski64_alias_free().
+ * @param weights Non-negative weights, not all zero. They need not be normalized.
+ * @param n       Number of outcomes, between 1 and 2^32 - 1.
+ * @return 0 on success, or -1 if the arguments are invalid or memory could not be allocated.
+ */
+static int biski64_alias_init(biski64_alias_table* table, const double* weights, size_t n) {
+    table->entries = NULL;
+    table->n = 0;
+    if (n == 0 || n > UINT32_MAX)
+        return -1;
+
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        if (!(weights[i] >= 0.0))
+            return -1;
+        sum += weights[i];
+    }
+    if (!(sum > 0.0) || sum > 1e300)
+        return -1;
+
+    biski64_alias_entry* entries = (biski64_alias_entry*)malloc(n * sizeof(biski64_alias_entry));
+    double* scaled = (double*)malloc(n * sizeof(double));
+    uint32_t* work = (uint32_t*)malloc(n * sizeof(uint32_t));
+    if (entries == NULL || scaled == NULL || work == NULL) {
+        free(entries);
+        free(scaled);
+        free(work);
+        return -1;
+    }
+
+    // Small columns are stacked from the front of work, large ones from the back.
+    size_t small = 0, large = n;
+    const double norm = (double)n / sum;
+    for (size_t i = 0; i < n; ++i) {
+        scaled[i] = weights[i] * norm;
+        if (scaled[i] < 1.0)
+            work[small++] = (uint32_t)i;
+        else
+            work[--large] = (uint32_t)i;
+    }
+
+    while (small > 0 && large < n) {
+        const uint32_t s = work[--small];
+        const uint32_t l = work[large++];
+
+        const double t = scaled[s] * 0x1p32;
+        entries[s].threshold = (t < 0x1p32 - 1.0) ? (uint32_t)(t + 0.5) : UINT32_MAX;
+        entries[s].alias = l;
+
+        scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+        if (scaled[l] < 1.0)
+            work[small++] = l;
+        else
+            work[--large] = l;
+    }
+
+    // Whatever is left is full up to rounding and always accepts.
+    while (small > 0) {
+        const uint32_t i = work[--small];
+        entries[i].threshold = UINT32_MAX;
+        entries[i].alias = i;
+    }
+    while (large < n) {
+        const uint32_t i = work[large++];
+        entries[i].threshold = UINT32_MAX;
+        entries[i].alias = i;
+    }
+
+    free(scaled);
+    free(work);
+    table->entries = entries;
+    table->n = (uint32_t)n;
+    return 0;
+}
+
+
+/**
+ * @brief Releases the memory held by an alias table.
+ */
+static void biski64_alias_free(biski64_alias_table* table) {
+    free(table->entries);
+    table->entries = NULL;
+    table->n = 0;
+}
+
+
+/**
+ * @brief Maps one 64-bit output to an outcome of the alias table.
+ *
+ * The column is the high half of bits * n (Lemire's multiply-shift, with bias below n / 2^64)
+ * and the top 32 bits of the low half, which are uniform within the column, are compared
+ * against its threshold. No further randomness is needed.
+ */
+static inline uint32_t biski64_alias_lookup(const biski64_alias_table* table, uint64_t bits) {
+    uint64_t lo;
+    const uint32_t column = (uint32_t)biski64_mul_hilo(bits, table->n, &lo);
+    const biski64_alias_entry entry = table->entries[column];
+    return ((uint32_t)(lo >> 32) < entry.threshold) ? column : entry.alias;
+}
+
+
+/**
+ * @brief Returns an outcome index drawn from the alias table's distribution, using one output.
+ *
+ * @param state Pointer to an initialized biski64_state structure.
+ * @param table Table built by biski64_alias_init().
+ * @return An index in [0, n).
+ */
+static inline uint32_t biski64_alias_sample(biski64_state* state, const biski64_alias_table* table) {
+    return biski64_alias_lookup(table, biski64_next(state));
+}
+
+
+/**
+ * @brief Fills an array with outcome indices drawn from the alias table's distribution.
+ *
+ * Outputs for a chunk are generated with biski64x8_fill() first, so the table loads of the
+ * lookup loop are independent and overlap in the memory system.
+ *
+ * @param state Pointer to an initialized biski64x8_state structure.
+ * @param table Table built by biski64_alias_init().
+ * @param out   Destination buffer with room for n indices. The caller must ensure this is not NULL.
+ * @param n     Number of indices to write.
+ */
+static void biski64x8_fill_alias(biski64x8_state* state, const biski64_alias_table* table, uint32_t* out, size_t n) {
+    uint64_t raw[BISKI64_BATCH_CHUNK];
+
+    for (size_t done = 0; done < n; ) {
+        const size_t m = (n - done < BISKI64_BATCH_CHUNK) ? n - done : BISKI64_BATCH_CHUNK;
+        biski64x8_fill(state, raw, m);
+        for (size_t j = 0; j < m; ++j)
+            out[done + j] = biski64_alias_lookup(table, raw[j]);
+        done += m;
+    }
+}
+
+
+/**
+ * @brief Weighted sampler over n items whose weights may change between draws.
+ *
+ * Prefix sums live in a Fenwick (binary indexed) tree, so updating a weight and drawing an
+ * item are both O(log n). The tree is rebuilt from the exact weights after every n
+ * single-item updates, which keeps floating-point drift bounded at amortized O(1) cost.
+ * Draws take a non-const sampler because a draw that finds the running total stale
+ * rebuilds it.
+ */
+typedef struct {
+    double* tree;      // 1-based Fenwick tree, n + 1 entries
+    double* weights;   // current weight of each item
+    double total;
+    double peak;       // largest total since the last rebuild
+    size_t n;
+    size_t top;        // highest power of two <= n
+    size_t updates;    // single-item updates since the last rebuild
+} biski64_weighted;
+
+
+/**
+ * @internal
+ * @brief Rebuilds the Fenwick tree and total from the stored weights in O(n).
+ */
+static void biski64_weighted_rebuild(biski64_weighted* sampler) {
+    const size_t n = sampler->n;
+    sampler->tree[0] = 0.0;
+    for (size_t i = 1; i <= n; ++i)
+        sampler->tree[i] = sampler->weights[i - 1];
+    for (size_t i = 1; i <= n; ++i) {
+        const size_t parent = i + (i & (~i + 1));
+        if (parent <= n)
+            sampler->tree[parent] += sampler->tree[i];
+    }
+
+    double total = 0.0;
+    for (size_t i = 0; i < n; ++i)
+        total += sampler->weights[i];
+    sampler->total = total;
+    sampler->peak = total;
+    sampler->updates = 0;
+}
+
+
+/**
+ * @brief Creates a dynamic weighted sampler over n items in O(n).
+ *
+ * @param sampler Pointer to the sampler to initialize; release it with biski64_weighted_free().
+ * @param weights Initial non-negative weights, or NULL to start with all weights zero.
+ * @param n       Number of items. Must be at least 1.
+ * @return 0 on success, or -1 if n is 0, a weight is negative, or memory could not be allocated.
+ */
+static int biski64_weighted_init(biski64_weighted* sampler, const double* weights, size_t n) {
+    sampler->tree = NULL;
+    sampler->weights = NULL;
+    sampler->n = 0;
+    if (n == 0 || n > SIZE_MAX / sizeof(double) - 1)
+        return -1;
+    for (size_t i = 0; weights != NULL && i < n; ++i)
+        if (!(weights[i] >= 0.0))
+            return -1;
+
+    sampler->tree = (double*)malloc((n + 1) * sizeof(double));
+    sampler->weights = (double*)malloc(n * sizeof(double));
+    if (sampler->tree == NULL || sampler->weights == NULL) {
+        free(sampler->tree);
+        free(sampler->weights);
+        sampler->tree = NULL;
+        sampler->weights = NULL;
+        return -1;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+        sampler->weights[i] = (weights != NULL) ? weights[i] : 0.0;
+    sampler->n = n;
+    sampler->top = 1;
+    while (sampler->top <= n / 2)
+        sampler->top <<= 1;
+
+    biski64_weighted_rebuild(sampler);
+    return 0;
+}
+
+
+/**
+ * @brief Releases the memory held by a weighted sampler.
+ */
+static void biski64_weighted_free(biski64_weighted* sampler) {
+    free(sampler->tree);
+    free(sampler->weights);
+    sampler->tree = NULL;
+    sampler->weights = NULL;
+    sampler->n = 0;
+}
+
+
+/**
+ * @brief Sets the weight of one item in O(log n).
+ *
+ * @param sampler Pointer to an initialized sampler.
+ * @param index   Item to change. The caller must ensure index < n.
+ * @param weight  New non-negative weight.
+ */
+static void biski64_weighted_set(biski64_weighted* sampler, size_t index, double weight) {
+    const double delta = weight - sampler->weights[index];
+    sampler->weights[index] = weight;
+
+    // Rebuild periodically, and whenever removals have cut the total far below its recent peak:
+    // the rounding error left by the larger totals would then dominate what remains.
+    sampler->total += delta;
+    if (sampler->total > sampler->peak)
+        sampler->peak = sampler->total;
+    if (++sampler->updates >= sampler->n || sampler->total < sampler->peak * 0x1p-20) {
+        biski64_weighted_rebuild(sampler);
+        return;
+    }
+
+    for (size_t i = index + 1; i <= sampler->n; i += i & (~i + 1))
+        sampler->tree[i] += delta;
+}
+
+
+/**
+ * @brief Applies a batch of weight changes.
+ *
+ * Small batches are applied one item at a time in O(count log n). Once count log2(n)
+ * exceeds n it is cheaper to store the weights and rebuild the tree in O(n + count).
+ *
+ * @param sampler Pointer to an initialized sampler.
+ * @param indices Items to change, each below n. Later entries win for repeated indices.
+ * @param weights New non-negative weights, parallel to indices.
+ * @param count   Number of changes.
+ */
+static void biski64_weighted_update(biski64_weighted* sampler, const size_t* indices, const double* weights, size_t count) {
+    size_t log_n = 1;
+    while (((size_t)1 << log_n) < sampler->n && log_n < 63)
+        ++log_n;
+
+    if (count > sampler->n / log_n) {
+        for (size_t k = 0; k < count; ++k)
+            sampler->weights[indices[k]] = weights[k];
+        biski64_weighted_rebuild(sampler);
+        return;
+    }
+
+    for (size_t k = 0; k < count; ++k)
+        biski64_weighted_set(sampler, indices[k], weights[k]);
+}
+
+
+/**
+ * @brief Returns the current sum of all weights.
+ */
+static inline double biski64_weighted_total(const biski64_weighted* sampler) {
+    return sampler->total;
+}
+
+
+/**
+ * @internal
+ * @brief Fenwick descent: returns the item whose prefix-sum interval contains target, or n if
+ * rounding carried target past the end.
+ */
+static inline size_t biski64_weighted_find(const biski64_weighted* sampler, double target) {
+    size_t pos = 0;
+    for (size_t step = sampler->top; step != 0; step >>= 1) {
+        const size_t next = pos + step;
+        if (next <= sampler->n && sampler->tree[next] <= target) {
+            pos = next;
+            target -= sampler->tree[next];
+        }
+    }
+    return pos;
+}
+
+
+/**
+ * @brief Draws an item with probability proportional to its current weight in O(log n).
+ *
+ * A descent that lands past the end or on a zero-weight item through rounding is redrawn,
+ * so zero-weight items are never returned. The first redraw rebuilds the tree, so a total
+ * that only drift keeps above zero cannot make the redraws loop forever.
+ *
+ * @param state   Pointer to an initialized biski64_state structure.
+ * @param sampler Pointer to an initialized sampler.
+ * @return The index of the chosen item, or n if every weight is zero.
+ */
+static size_t biski64_weighted_sample(biski64_state* state, biski64_weighted* sampler) {
+    int rebuilt = 0;
+    while (sampler->total > 0.0) {
+        const size_t index = biski64_weighted_find(sampler, biski64_next_unit(state) * sampler->total);
+        if (index < sampler->n && sampler->weights[index] > 0.0)
+            return index;
+        if (!rebuilt) {
+            biski64_weighted_rebuild(sampler);
+            rebuilt = 1;
+        }
+    }
+    return sampler->n;
+}
+
+
+/**
+ * @brief Fills an array with items drawn in proportion to the current weights.
+ *
+ * The descents for a chunk run level by level, so the tree loads of different draws are
+ * independent and overlap in the memory system. Rare redraws are done in order on lane 0
+ * of the engine.
+ *
+ * @param state   Pointer to an initialized biski64x8_state structure.
+ * @param sampler Pointer to an initialized sampler. If every weight is zero, each index is n.
+ * @param out     Destination buffer with room for n indices. The caller must ensure this is not NULL.
+ * @param n       Number of indices to write.
+ */
+static void biski64x8_fill_weighted(biski64x8_state* state, biski64_weighted* sampler, size_t* out, size_t n) {
+    double target[BISKI64_BATCH_CHUNK];
+
+    for (size_t done = 0; done < n; ) {
+        const size_t m = (n - done < BISKI64_BATCH_CHUNK) ? n - done : BISKI64_BATCH_CHUNK;
+        size_t* pos = out + done;
+
+        biski64x8_fill_double(state, target, m);
+        for (size_t j = 0; j < m; ++j) {
+            target[j] *= sampler->total;
+            pos[j] = 0;
+        }
+
+        for (size_t step = sampler->top; step != 0; step >>= 1) {
+            for (size_t j = 0; j < m; ++j) {
+                const size_t next = pos[j] + step;
+                if (next <= sampler->n && sampler->tree[next] <= target[j]) {
+                    pos[j] = next;
+                    target[j] -= sampler->tree[next];
+                }
+            }
+        }
+
+        biski64_state lane = biski64x8_get_lane(state, 0);
+        for (size_t j = 0; j < m; ++j) {
+            if (pos[j] >= sampler->n || !(sampler->weights[pos[j]] > 0.0))
+                pos[j] = biski64_weighted_sample(&lane, sampler);
+        }
+        biski64x8_set_lane(state, 0, &lane);
+
+        done += m;
+    }
+}
+
+
+/**
+ * @brief Precomputed constants for Zipf sampling over ranks 1..n with P(k) proportional to
+ * k^-exponent, by Hormann and Derflinger's rejection-inversion.
+ *
+ * The setup is O(1) and no table is built, so n can be as large as 2^53.
+ */
+typedef struct {
+    double exponent;
+    double n;
+    double h_integral_x1;     // H(1.5) - 1
+    double h_integral_n;      // H(n + 0.5)
+    double s;                 // squeeze bound: 2 - H^-1(H(2.5) - h(2))
+} biski64_zipf_params;
+
+
+/**
+ * @internal
+ * @brief log1p(x) / x, continuous at 0.
+ */
+static inline double biski64_zipf_helper1(double x) {
+    return (fabs(x) > 1e-8) ? log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+
+/**
+ * @internal
+ * @brief expm1(x) / x, continuous at 0.
+ */
+static inline double biski64_zipf_helper2(double x) {
+    return (fabs(x) > 1e-8) ? expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+}
+
+
+/**
+ * @internal
+ * @brief H(x) = integral of x^-exponent, valid for every exponent including 1.
+ */
+static inline double biski64_zipf_h_integral(double exponent, double x) {
+    const double log_x = log(x);
+    return biski64_zipf_helper2((1.0 - exponent) * log_x) * log_x;
+}
+
+
+/**
+ * @internal
+ * @brief h(x) = x^-exponent.
+ */
+static inline double biski64_zipf_h(double exponent, double x) {
+    return exp(-exponent * log(x));
+}
+
+
+/**
+ * @internal
+ * @brief Inverse of biski64_zipf_h_integral().
+ */
+static inline double biski64_zipf_h_integral_inverse(double exponent, double x) {
+    double t = x * (1.0 - exponent);
+    if (t < -1.0)
+        t = -1.0;  // Limit the argument to avoid NaN from rounding
+    return exp(biski64_zipf_helper1(t) * x);
+}
+
+
+/**
+ * @brief Prepares the constants for drawing Zipf ranks.
+ *
+ * @param params   Pointer to the structure to initialize.
+ * @param n        Number of ranks. Must be at least 1.
+ * @param exponent Exponent s of the distribution. Must be positive.
+ */
+static void biski64_zipf_init(biski64_zipf_params* params, uint64_t n, double exponent) {
+    params->exponent = exponent;
+    params->n = (double)n;
+    params->h_integral_x1 = biski64_zipf_h_integral(exponent, 1.5) - 1.0;
+    params->h_integral_n = biski64_zipf_h_integral(exponent, params->n + 0.5);
+    params->s = 2.0 - biski64_zipf_h_integral_inverse(exponent,
+                          biski64_zipf_h_integral(exponent, 2.5) - biski64_zipf_h(exponent, 2.0));
+}
+
+
+/**
+ * @internal
+ * @brief One rejection-inversion attempt from a uniform v in [0, 1).
+ * On acceptance writes the rank to *out and returns 1.
+ */
+static inline int biski64_zipf_attempt(const biski64_zipf_params* params, double v, uint64_t* out) {
+    const double u = params->h_integral_n + v * (params->h_integral_x1 - params->h_integral_n);
+    const double x = biski64_zipf_h_integral_inverse(params->exponent, u);
+
+    double k = floor(x + 0.5);
+    if (k < 1.0)
+        k = 1.0;
+    else if (k > params->n)
+        k = params->n;
+
+    if (k - x <= params->s
+            || u >= biski64_zipf_h_integral(params->exponent, k + 0.5) - biski64_zipf_h(params->exponent, k)) {
+        *out = (uint64_t)k;
+        return 1;
+    }
+    return 0;
+}
+
+
+/**
+ * @brief Returns a Zipf-distributed rank in [1, n] for precomputed parameters.
+ *
+ * The expected number of uniforms per draw is below 1.1 for every exponent and n.
+ *
+ * @param state  Pointer to an initialized biski64_state structure.
+ * @param params Parameters prepared by biski64_zipf_init().
+ * @return A rank in [1, n]; rank 1 is the most likely.
+ */
+static uint64_t biski64_zipf_sample(biski64_state* state, const biski64_zipf_params* params) {
+    for (;;) {
+        uint64_t k;
+        if (biski64_zipf_attempt(params, biski64_next_unit(state), &k))
+            return k;
+    }
+}
+
+
+/**
+ * @brief Fills an array with Zipf-distributed ranks in [1, n], e.g. keys for a request replayer.
+ *
+ * Uniforms for a chunk come from biski64x8_fill_double(); rejected attempts are redrawn in
+ * order on lane 0 of the engine, so the output does not depend on the kernel in use.
+ *
+ * @param state  Pointer to an initialized biski64x8_state structure.
+ * @param params Parameters prepared by biski64_zipf_init().
+ * @param out    Destination buffer with room for n ranks. The caller must ensure this is not NULL.
+ * @param n      Number of ranks to write.
+ */
+static void biski64x8_fill_zipf(biski64x8_state* state, const biski64_zipf_params* params, uint64_t* out, size_t n) {
+    double v[BISKI64_BATCH_CHUNK];
+
+    for (size_t done = 0; done < n; ) {
+        const size_t m = (n - done < BISKI64_BATCH_CHUNK) ? n - done : BISKI64_BATCH_CHUNK;
+        biski64x8_fill_double(state, v, m);
+
+        biski64_state lane = biski64x8_get_lane(state, 0);
+        for (size_t j = 0; j < m; ++j) {
+            if (!biski64_zipf_attempt(params, v[j], &out[done + j]))
+                out[done + j] = biski64_zipf_sample(&lane, params);
+        }
+        biski64x8_set_lane(state, 0, &lane);
+
+        done += m;
+    }
+}
+
+
+/**
+ * @brief Returns a Pareto variate with minimum x_m and tail index alpha, computed as
+ * x_m * exp(E / alpha) from a ziggurat exponential E.
+ */
+static inline double biski64_pareto(biski64_state* state, double x_m, double alpha) {
+    return x_m * exp(biski64_exponential(state) / alpha);
+}
+
+
+/**
+ * @brief Fills an array with Pareto variates with minimum x_m and tail index alpha.
+ */
+static void biski64x8_fill_pareto(biski64x8_state* state, double* out, size_t n, double x_m, double alpha) {
+    biski64x8_fill_exponential(state, out, n, alpha);
+    for (size_t j = 0; j < n; ++j)
+        out[j] = x_m * exp(out[j]);
+}
+
+
+/**
+ * @brief Returns a log-normal variate exp(mu + sigma Z) with Z a ziggurat normal.
+ */
+static inline double biski64_lognormal(biski64_state* state, double mu, double sigma) {
+    return exp(mu + sigma * biski64_normal(state));
+}
+
+
+/**
+ * @brief Fills an array with log-normal variates whose logarithms have mean mu and
+ * standard deviation sigma.
+ */
+static void biski64x8_fill_lognormal(biski64x8_state* state, double* out, size_t n, double mu, double sigma) {
+    biski64x8_fill_normal(state, out, n, mu, sigma);
+    for (size_t j = 0; j < n; ++j)
+        out[j] = exp(out[j]);
+}
+
+
+/**
+ * @internal
+ * @brief Natural logarithm of a positive, finite, normal double, with relative error below
+ * 1e-12, written so that the AVX2 and AVX-512 versions below perform the same IEEE operations
+ * (every multiply-add is an explicit fma) and return identical bits.
+ *
+ * x = m 2^e with m in [sqrt(1/2), sqrt(2)); log(m) = 2 atanh(s), s = (m - 1) / (m + 1),
+ * evaluated as an odd series in s up to s^15.
+ */
+static inline double biski64_gumbel_log(double x) {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+
+    double e = (double)(bits >> 52) - 1023.0;
+    const uint64_t m_bits = (bits & 0x000FFFFFFFFFFFFFULL) | 0x3FF0000000000000ULL;
+    double m;
+    memcpy(&m, &m_bits, sizeof(m));
+    if (m > 1.4142135623730951) {
+        m *= 0.5;
+        e += 1.0;
+    }
+
+    const double f = m - 1.0;
+    const double s = f / (f + 2.0);
+    const double z = s * s;
+
+    double p = 1.0 / 15.0;
+    p = fma(p, z, 1.0 / 13.0);
+    p = fma(p, z, 1.0 / 11.0);
+    p = fma(p, z, 1.0 / 9.0);
+    p = fma(p, z, 1.0 / 7.0);
+    p = fma(p, z, 1.0 / 5.0);
+    p = fma(p, z, 1.0 / 3.0);
+
+    const double t = s + s;
+    return fma(e, 0.6931471805599453, fma(t * z, p, t));
+}
+
+
+/**
+ * @internal
+ * @brief Perturbed score logit / T + G with G = -log(-log(u)) a Gumbel variate, u in (0, 1).
+ */
+static inline double biski64_gumbel_score(double logit, double inv_temperature, double u) {
+    return fma(logit, inv_temperature, -biski64_gumbel_log(-biski64_gumbel_log(u)));
+}
+
+
+/**
+ * @internal
+ * @brief Running argmax of a Gumbel-max scan. Strict comparisons keep the earliest index on
+ * ties, and NaN scores are never selected.
+ */
+typedef struct {
+    double score;
+    size_t index;
+} biski64_gumbel_best;
+
+
+/**
+ * @internal
+ * @brief Portable Gumbel-max scan of logits[0..n); uniforms come from biski64x8_fill_double_open().
+ */
+static void biski64_gumbel_scan(biski64x8_state* state, const float* logits, size_t n, double inv_temperature,
+                                biski64_gumbel_best* best) {
+    double u[BISKI64_BATCH_CHUNK];
+
+    for (size_t done = 0; done < n; ) {
+        const size_t m = (n - done < BISKI64_BATCH_CHUNK) ? n - done : BISKI64_BATCH_CHUNK;
+        biski64x8_fill_double_open(state, u, m);
+        for (size_t j = 0; j < m; ++j) {
+            const double score = biski64_gumbel_score(logits[done + j], inv_temperature, u[j]);
+            if (score > best->score) {
+                best->score = score;
+                best->index = done + j;
+            }
+        }
+        done += m;
+    }
+}
+
+
+#ifdef BISKI64_X86_SIMD
+/**
+ * @internal
+ * @brief AVX2 version of biski64_gumbel_log() on four doubles.
+ * The caller must ensure the CPU supports AVX2 and FMA.
+ */
+__attribute__((target("avx2,fma")))
+static inline __m256d biski64_gumbel_log_avx2(__m256d x) {
+    const __m256i bits = _mm256_castpd_si256(x);
+    const __m256d magic = _mm256_set1_pd(0x1p52);
+
+    __m256d e = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_castpd_si256(magic))), magic);
+    e = _mm256_sub_pd(e, _mm256_set1_pd(1023.0));
+    __m256d m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)),
+                                                    _mm256_set1_epi64x(0x3FF0000000000000LL)));
+    const __m256d big = _mm256_cmp_pd(m, _mm256_set1_pd(1.4142135623730951), _CMP_GT_OQ);
+    m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), big);
+    e = _mm256_blendv_pd(e, _mm256_add_pd(e, _mm256_set1_pd(1.0)), big);
+
+    const __m256d f = _mm256_sub_pd(m, _mm256_set1_pd(1.0));
+    const __m256d s = _mm256_div_pd(f, _mm256_add_pd(f, _mm256_set1_pd(2.0)));
+    const __m256d z = _mm256_mul_pd(s, s);
+
+    __m256d p = _mm256_set1_pd(1.0 / 15.0);
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 13.0));
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 11.0));
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 9.0));
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 7.0));
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 5.0));
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 3.0));
+
+    const __m256d t = _mm256_add_pd(s, s);
+    return _mm256_fmadd_pd(e, _mm256_set1_pd(0.6931471805599453), _mm256_fmadd_pd(_mm256_mul_pd(t, z), p, t));
+}
+
+
+/**
+ * @internal
+ * @brief AVX2 Gumbel-max scan: generation, the double-log transform and the running argmax in
+ * registers, four lanes per chain and two chains to cover the eight engine lanes.
+ * The caller must ensure the CPU supports AVX2 and FMA.
+ */
+__attribute__((target("avx2,fma")))
+static void biski64_gumbel_scan_avx2(biski64x8_state* state, const float* logits, size_t n, double inv_temperature,
+                                     biski64_gumbel_best* best) {
+    const __m256i exponent = _mm256_set1_epi64x(0x3FF0000000000000LL);
+    const __m256d sub      = _mm256_set1_pd(1.0 - 0x1p-53);
+    const __m256d inv_t    = _mm256_set1_pd(inv_temperature);
+    const __m256d zero     = _mm256_setzero_pd();
+
+    __m256i fast_loop_a = _mm256_loadu_si256((const __m256i*)state->fast_loop);
+    __m256i mix_a       = _mm256_loadu_si256((const __m256i*)state->mix);
+    __m256i loop_mix_a  = _mm256_loadu_si256((const __m256i*)state->loop_mix);
+    __m256i fast_loop_b = _mm256_loadu_si256((const __m256i*)(state->fast_loop + 4));
+    __m256i mix_b       = _mm256_loadu_si256((const __m256i*)(state->mix + 4));
+    __m256i loop_mix_b  = _mm256_loadu_si256((const __m256i*)(state->loop_mix + 4));
+
+    __m256d best_a = _mm256_set1_pd(-INFINITY), best_b = best_a;
+    __m256d index_a = _mm256_set1_pd(-1.0), index_b = index_a;
+    __m256d lane_a = _mm256_setr_pd(0.0, 1.0, 2.0, 3.0);
+    __m256d lane_b = _mm256_setr_pd(4.0, 5.0, 6.0, 7.0);
+    const __m256d step = _mm256_set1_pd(8.0);
+
+    const size_t full = n - n % 8;
+
+    for (size_t i = 0; i < full; i += 8) {
+        const __m256i output_a = biski64_step_avx2(&fast_loop_a, &mix_a, &loop_mix_a);
+        const __m256i output_b = biski64_step_avx2(&fast_loop_b, &mix_b, &loop_mix_b);
+        const __m256d u_a = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(output_a, 12), exponent)), sub);
+        const __m256d u_b = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(output_b, 12), exponent)), sub);
+
+        const __m256d g_a = _mm256_sub_pd(zero, biski64_gumbel_log_avx2(_mm256_sub_pd(zero, biski64_gumbel_log_avx2(u_a))));
+        const __m256d g_b = _mm256_sub_pd(zero, biski64_gumbel_log_avx2(_mm256_sub_pd(zero, biski64_gumbel_log_avx2(u_b))));
+        const __m256d score_a = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(logits + i)), inv_t, g_a);
+        const __m256d score_b = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(logits + i + 4)), inv_t, g_b);
+
+        const __m256d better_a = _mm256_cmp_pd(score_a, best_a, _CMP_GT_OQ);
+        const __m256d better_b = _mm256_cmp_pd(score_b, best_b, _CMP_GT_OQ);
+        best_a  = _mm256_blendv_pd(best_a, score_a, better_a);
+        best_b  = _mm256_blendv_pd(best_b, score_b, better_b);
+        index_a = _mm256_blendv_pd(index_a, lane_a, better_a);
+        index_b = _mm256_blendv_pd(index_b, lane_b, better_b);
+        lane_a  = _mm256_add_pd(lane_a, step);
+        lane_b  = _mm256_add_pd(lane_b, step);
+    }
+
+    _mm256_storeu_si256((__m256i*)state->fast_loop, fast_loop_a);
+    _mm256_storeu_si256((__m256i*)state->mix, mix_a);
+    _mm256_storeu_si256((__m256i*)state->loop_mix, loop_mix_a);
+    _mm256_storeu_si256((__m256i*)(state->fast_loop + 4), fast_loop_b);
+    _mm256_storeu_si256((__m256i*)(state->mix + 4), mix_b);
+    _mm256_storeu_si256((__m256i*)(state->loop_mix + 4), loop_mix_b);
+
+    // Merge the lanes: highest score, earliest index among equal scores.
+    double lane_best[8], lane_index[8];
+    _mm256_storeu_pd(lane_best, best_a);
+    _mm256_storeu_pd(lane_best + 4, best_b);
+    _mm256_storeu_pd(lane_index, index_a);
+    _mm256_storeu_pd(lane_index + 4, index_b);
+    for (int k = 0; k < 8; ++k) {
+        if (lane_index[k] < 0.0)
+            continue;
+        const size_t index = (size_t)lane_index[k];
+        if (lane_best[k] > best->score || (lane_best[k] == best->score && index < best->index)) {
+            best->score = lane_best[k];
+            best->index = index;
+        }
+    }
+
+    biski64_gumbel_best tail = { -INFINITY, 0 };
+    biski64_gumbel_scan(state, logits + full, n % 8, inv_temperature, &tail);
+    if (tail.score > best->score) {
+        best->score = tail.score;
+        best->index = full + tail.index;
+    }
+}
+
+
+/**
+ * @internal
+ * @brief AVX-512 version of biski64_gumbel_log() on eight doubles.
+ * The caller must ensure the CPU supports AVX-512F.
+ */
+__attribute__((target("avx512f")))
+static inline __m512d biski64_gumbel_log_avx512(__m512d x) {
+    const __m512i bits = _mm512_castpd_si512(x);
+    const __m512d magic = _mm512_set1_pd(0x1p52);
+
+    __m512d e = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(bits, 52), _mm512_castpd_si512(magic))), magic);
+    e = _mm512_sub_pd(e, _mm512_set1_pd(1023.0));
+    __m512d m = _mm512_castsi512_pd(_mm512_or_si512(_mm512_and_si512(bits, _mm512_set1_epi64(0x000FFFFFFFFFFFFFLL)),
+                                                    _mm512_set1_epi64(0x3FF0000000000000LL)));
+    const __mmask8 big = _mm512_cmp_pd_mask(m, _mm512_set1_pd(1.4142135623730951), _CMP_GT_OQ);
+    m = _mm512_mask_mul_pd(m, big, m, _mm512_set1_pd(0.5));
+    e = _mm512_mask_add_pd(e, big, e, _mm512_set1_pd(1.0));
+
+    const __m512d f = _mm512_sub_pd(m, _mm512_set1_pd(1.0));
+    const __m512d s = _mm512_div_pd(f, _mm512_add_pd(f, _mm512_set1_pd(2.0)));
+    const __m512d z = _mm512_mul_pd(s, s);
+
+    __m512d p = _mm512_set1_pd(1.0 / 15.0);
+    p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(1.0 / 13.0));
+    p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(1.0 / 11.0));
+    p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(1.0 / 9.0));
+    p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(1.0 / 7.0));
+    p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(1.0 / 5.0));
+    p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(1.0 / 3.0));
+
+    const __m512d t = _mm512_add_pd(s, s);
+    return _mm512_fmadd_pd(e, _mm512_set1_pd(0.6931471805599453), _mm512_fmadd_pd(_mm512_mul_pd(t, z), p, t));
+}
+
+
+/**
+ * @internal
+ * @brief AVX-512 Gumbel-max scan with generation, transform and running argmax in registers.
+ * The caller must ensure the CPU supports AVX-512F.
+ */
+__attribute__((target("avx512f")))
+static void biski64_gumbel_scan_avx512(biski64x8_state* state, const float* logits, size_t n, double inv_temperature,
+                                       biski64_gumbel_best* best) {
+    const __m512i exponent = _mm512_set1_epi64(0x3FF0000000000000LL);
+    const __m512d sub      = _mm512_set1_pd(1.0 - 0x1p-53);
+    const __m512d inv_t    = _mm512_set1_pd(inv_temperature);
+    const __m512d zero     = _mm512_setzero_pd();
+
+    __m512i fast_loop = _mm512_loadu_si512(state->fast_loop);
+    __m512i mix       = _mm512_loadu_si512(state->mix);
+    __m512i loop_mix  = _mm512_loadu_si512(state->loop_mix);
+
+    __m512d best_score = _mm512_set1_pd(-INFINITY);
+    __m512d best_index = _mm512_set1_pd(-1.0);
+    __m512d lane = _mm512_setr_pd(0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0);
+    const __m512d step = _mm512_set1_pd(8.0);
+
+    const size_t full = n - n % 8;
+
+    for (size_t i = 0; i < full; i += 8) {
+        const __m512i output = biski64_step_avx512(&fast_loop, &mix, &loop_mix);
+        const __m512d u = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(output, 12), exponent)), sub);
+
+        const __m512d g = _mm512_sub_pd(zero, biski64_gumbel_log_avx512(_mm512_sub_pd(zero, biski64_gumbel_log_avx512(u))));
+        const __m512d score = _mm512_fmadd_pd(_mm512_cvtps_pd(_mm256_loadu_ps(logits + i)), inv_t, g);
+
+        const __mmask8 better = _mm512_cmp_pd_mask(score, best_score, _CMP_GT_OQ);
+        best_score = _mm512_mask_mov_pd(best_score, better, score);
+        best_index = _mm512_mask_mov_pd(best_index, better, lane);
+        lane = _mm512_add_pd(lane, step);
+    }
+
+    _mm512_storeu_si512(state->fast_loop, fast_loop);
+    _mm512_storeu_si512(state->mix, mix);
+    _mm512_storeu_si512(state->loop_mix, loop_mix);
+
+    double lane_best[8], lane_index[8];
+    _mm512_storeu_pd(lane_best, best_score);
+    _mm512_storeu_pd(lane_index, best_index);
+    for (int k = 0; k < 8; ++k) {
+        if (lane_index[k] < 0.0)
+            continue;
+        const size_t index = (size_t)lane_index[k];
+        if (lane_best[k] > best->score || (lane_best[k] == best->score && index < best->index)) {
+            best->score = lane_best[k];
+            best->index = index;
+        }
+    }
+
+    biski64_gumbel_best tail = { -INFINITY, 0 };
+    biski64_gumbel_scan(state, logits + full, n % 8, inv_temperature, &tail);
+    if (tail.score > best->score) {
+        best->score = tail.score;
+        best->index = full + tail.index;
+    }
+}
+#endif // BISKI64_X86_SIMD
+
+
+/**
+ * @internal
+ * @brief Runs the best available Gumbel-max scan over logits[0..n). The result's index is n
+ * if no score beats -infinity.
+ */
+static biski64_gumbel_best biski64_gumbel_argmax(biski64x8_state* state, const float* logits, size_t n, double inv_temperature) {
+    biski64_gumbel_best best = { -INFINITY, n };
+#ifdef BISKI64_X86_SIMD
+    if (biski64_kernel_in_use() == BISKI64_KERNEL_AVX512)
+        biski64_gumbel_scan_avx512(state, logits, n, inv_temperature, &best);
+    else if (biski64_kernel_in_use() == BISKI64_KERNEL_AVX2 && __builtin_cpu_supports("fma"))
+        biski64_gumbel_scan_avx2(state, logits, n, inv_temperature, &best);
+    else
+#endif
+        biski64_gumbel_scan(state, logits, n, inv_temperature, &best);
+    return best;
+}
+
+
+/**
+ * @internal
+ * @brief Index of the largest logit (first on ties), or n if none is above -infinity.
+ */
+static size_t biski64_logits_argmax(const float* logits, size_t n) {
+    size_t index = n;
+    float best = -INFINITY;
+    for (size_t i = 0; i < n; ++i) {
+        if (logits[i] > best) {
+            best = logits[i];
+            index = i;
+        }
+    }
+    return index;
+}
+
+
+/**
+ * @brief Samples an index from softmax(logits / temperature) by the Gumbel-max trick.
+ *
+ * Each logit gets independent Gumbel noise -log(-log(u)) and the index of the largest
+ * perturbed score is returned, so no softmax or CDF is built. On the AVX2 (with FMA) and
+ * AVX-512 tiers, generation, the transform and the argmax are fused in registers. The
+ * logarithm is a polynomial with relative error below 1e-12 that every tier evaluates with
+ * the same operations, so the chosen index does not depend on the kernel in use; it uses
+ * fma(), which is slow on targets without hardware FMA.
+ *
+ * Consumes exactly n outputs from the engine, in biski64x8_fill() order.
+ *
+ * @param state       Pointer to an initialized biski64x8_state structure.
+ * @param logits      Unnormalized log-probabilities. -INFINITY masks an entry; NaNs are never chosen.
+ * @param n           Number of logits.
+ * @param temperature Softmax temperature. At 0 or below, returns the plain argmax without drawing.
+ * @return The sampled index, or n if every logit is masked.
+ */
+static size_t biski64x8_gumbel_sample(biski64x8_state* state, const float* logits, size_t n, double temperature) {
+    if (!(temperature > 0.0))
+        return biski64_logits_argmax(logits, n);
+    return biski64_gumbel_argmax(state, logits, n, 1.0 / temperature).index;
+}
+
+
+/**
+ * @internal
+ * @brief Restores the min-heap property below position i of heap[0..k).
+ */
+static void biski64_min_heap_sift(float* heap, size_t k, size_t i) {
+    for (;;) {
+        size_t smallest = i;
+        const size_t left = 2 * i + 1, right = left + 1;
+        if (left < k && heap[left] < heap[smallest])
+            smallest = left;
+        if (right < k && heap[right] < heap[smallest])
+            smallest = right;
+        if (smallest == i)
+            return;
+        const float t = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = t;
+        i = smallest;
+    }
+}
+
+
+/**
+ * @brief Samples from softmax(logits / temperature) restricted to the k largest logits.
+ *
+ * The k-th largest logit is found with a size-k min-heap in O(n log k), the surviving
+ * entries (all of them if there are ties at the cutoff) are compacted a chunk at a time, and
+ * the Gumbel-max scan runs over the survivors only, consuming one output per survivor.
+ *
+ * @param state       Pointer to an initialized biski64x8_state structure.
+ * @param logits      Unnormalized log-probabilities; NaNs are never chosen.
+ * @param n           Number of logits.
+ * @param k           Number of top entries to keep. k >= n keeps every entry.
+ * @param temperature Softmax temperature. At 0 or below, returns the plain argmax without drawing.
+ * @return The sampled index, or n if nothing can be chosen or memory for the heap is unavailable.
+ */
+static size_t biski64x8_gumbel_sample_top_k(biski64x8_state* state, const float* logits, size_t n, size_t k, double temperature) {
+    if (!(temperature > 0.0) || k == 1)
+        return biski64_logits_argmax(logits, n);
+    if (k == 0)
+        return n;
+    if (k >= n)
+        return biski64_gumbel_argmax(state, logits, n, 1.0 / temperature).index;
+
+    float small_heap[256];
+    float* heap = (k <= 256) ? small_heap : (float*)malloc(k * sizeof(float));
+    if (heap == NULL)
+        return n;
+
+    size_t filled = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const float x = logits[i];
+        if (x != x)
+            continue;
+        if (filled < k) {
+            heap[filled++] = x;
+            if (filled == k)
+                for (size_t j = k / 2; j-- > 0; )
+                    biski64_min_heap_sift(heap, k, j);
+        } else if (x > heap[0]) {
+            heap[0] = x;
+            biski64_min_heap_sift(heap, k, 0);
+        }
+    }
+    const float cutoff = (filled == k) ? heap[0] : -INFINITY;
+    if (heap != small_heap)
+        free(heap);
+
+    // Chunks of BISKI64_BATCH_CHUNK keep the engine order identical to one scan over all survivors.
+    float kept[BISKI64_BATCH_CHUNK];
+    size_t kept_index[BISKI64_BATCH_CHUNK];
+    biski64_gumbel_best best = { -INFINITY, n };
+    const double inv_temperature = 1.0 / temperature;
+
+    size_t count = 0;
+    for (size_t i = 0; i <= n; ++i) {
+        if (i < n && logits[i] >= cutoff) {
+            kept[count] = logits[i];
+            kept_index[count++] = i;
+        }
+        if (count == BISKI64_BATCH_CHUNK || (i == n && count > 0)) {
+            const biski64_gumbel_best chunk = biski64_gumbel_argmax(state, kept, count, inv_temperature);
+            if (chunk.index < count && chunk.score > best.score) {
+                best.score = chunk.score;
+                best.index = kept_index[chunk.index];
+            }
+            count = 0;
+        }
+    }
+    return best.index;
+}
+
+#endif // BISKI64_DIST_C
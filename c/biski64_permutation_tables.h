@@ -0,0 +1,141 @@
+#ifndef BISKI64_PERMUTATION_TABLES_H
+#define BISKI64_PERMUTATION_TABLES_H
+
+// Precomputed tables for the small-array shuffles in biski64_shuffle.c. Index vectors are
+// packed one byte per position, lowest byte first, in the layout that pshufb consumes.
+
+
+// The 24 permutations of 4 elements in lexicographic order.
+static const uint32_t biski64_perm4[24] = {
+    0x03020100, 0x02030100, 0x03010200, 0x01030200, 0x02010300, 0x01020300,
+    0x03020001, 0x02030001, 0x03000201, 0x00030201, 0x02000301, 0x00020301,
+    0x03010002, 0x01030002, 0x03000102, 0x00030102, 0x01000302, 0x00010302,
+    0x02010003, 0x01020003, 0x02000103, 0x00020103, 0x01000203, 0x00010203
+};
+
+
+// All bytes ordered by number of set bits, then by value; the bytes with k set bits start at
+// biski64_weight_start[k].
+static const uint8_t biski64_bytes_by_weight[256] = {
+    0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x03, 0x05, 0x06, 0x09, 0x0A, 0x0C, 0x11,
+    0x12, 0x14, 0x18, 0x21, 0x22, 0x24, 0x28, 0x30, 0x41, 0x42, 0x44, 0x48, 0x50, 0x60, 0x81, 0x82,
+    0x84, 0x88, 0x90, 0xA0, 0xC0, 0x07, 0x0B, 0x0D, 0x0E, 0x13, 0x15, 0x16, 0x19, 0x1A, 0x1C, 0x23,
+    0x25, 0x26, 0x29, 0x2A, 0x2C, 0x31, 0x32, 0x34, 0x38, 0x43, 0x45, 0x46, 0x49, 0x4A, 0x4C, 0x51,
+    0x52, 0x54, 0x58, 0x61, 0x62, 0x64, 0x68, 0x70, 0x83, 0x85, 0x86, 0x89, 0x8A, 0x8C, 0x91, 0x92,
+    0x94, 0x98, 0xA1, 0xA2, 0xA4, 0xA8, 0xB0, 0xC1, 0xC2, 0xC4, 0xC8, 0xD0, 0xE0, 0x0F, 0x17, 0x1B,
+    0x1D, 0x1E, 0x27, 0x2B, 0x2D, 0x2E, 0x33, 0x35, 0x36, 0x39, 0x3A, 0x3C, 0x47, 0x4B, 0x4D, 0x4E,
+    0x53, 0x55, 0x56, 0x59, 0x5A, 0x5C, 0x63, 0x65, 0x66, 0x69, 0x6A, 0x6C, 0x71, 0x72, 0x74, 0x78,
+    0x87, 0x8B, 0x8D, 0x8E, 0x93, 0x95, 0x96, 0x99, 0x9A, 0x9C, 0xA3, 0xA5, 0xA6, 0xA9, 0xAA, 0xAC,
+    0xB1, 0xB2, 0xB4, 0xB8, 0xC3, 0xC5, 0xC6, 0xC9, 0xCA, 0xCC, 0xD1, 0xD2, 0xD4, 0xD8, 0xE1, 0xE2,
+    0xE4, 0xE8, 0xF0, 0x1F, 0x2F, 0x37, 0x3B, 0x3D, 0x3E, 0x4F, 0x57, 0x5B, 0x5D, 0x5E, 0x67, 0x6B,
+    0x6D, 0x6E, 0x73, 0x75, 0x76, 0x79, 0x7A, 0x7C, 0x8F, 0x97, 0x9B, 0x9D, 0x9E, 0xA7, 0xAB, 0xAD,
+    0xAE, 0xB3, 0xB5, 0xB6, 0xB9, 0xBA, 0xBC, 0xC7, 0xCB, 0xCD, 0xCE, 0xD3, 0xD5, 0xD6, 0xD9, 0xDA,
+    0xDC, 0xE3, 0xE5, 0xE6, 0xE9, 0xEA, 0xEC, 0xF1, 0xF2, 0xF4, 0xF8, 0x3F, 0x5F, 0x6F, 0x77, 0x7B,
+    0x7D, 0x7E, 0x9F, 0xAF, 0xB7, 0xBB, 0xBD, 0xBE, 0xCF, 0xD7, 0xDB, 0xDD, 0xDE, 0xE7, 0xEB, 0xED,
+    0xEE, 0xF3, 0xF5, 0xF6, 0xF9, 0xFA, 0xFC, 0x7F, 0xBF, 0xDF, 0xEF, 0xF7, 0xFB, 0xFD, 0xFE, 0xFF
+};
+
+static const uint16_t biski64_weight_start[10] = { 0, 1, 9, 37, 93, 163, 219, 247, 255, 256 };
+
+
+// For each byte m: the positions of its set bits in increasing order, followed by the
+// positions of its clear bits in increasing order.
+static const uint64_t biski64_split8[256] = {
+    0x0706050403020100ULL, 0x0706050403020100ULL, 0x0706050403020001ULL, 0x0706050403020100ULL,
+    0x0706050403010002ULL, 0x0706050403010200ULL, 0x0706050403000201ULL, 0x0706050403020100ULL,
+    0x0706050402010003ULL, 0x0706050402010300ULL, 0x0706050402000301ULL, 0x0706050402030100ULL,
+    0x0706050401000302ULL, 0x0706050401030200ULL, 0x0706050400030201ULL, 0x0706050403020100ULL,
+    0x0706050302010004ULL, 0x0706050302010400ULL, 0x0706050302000401ULL, 0x0706050302040100ULL,
+    0x0706050301000402ULL, 0x0706050301040200ULL, 0x0706050300040201ULL, 0x0706050304020100ULL,
+    0x0706050201000403ULL, 0x0706050201040300ULL, 0x0706050200040301ULL, 0x0706050204030100ULL,
+    0x0706050100040302ULL, 0x0706050104030200ULL, 0x0706050004030201ULL, 0x0706050403020100ULL,
+    0x0706040302010005ULL, 0x0706040302010500ULL, 0x0706040302000501ULL, 0x0706040302050100ULL,
+    0x0706040301000502ULL, 0x0706040301050200ULL, 0x0706040300050201ULL, 0x0706040305020100ULL,
+    0x0706040201000503ULL, 0x0706040201050300ULL, 0x0706040200050301ULL, 0x0706040205030100ULL,
+    0x0706040100050302ULL, 0x0706040105030200ULL, 0x0706040005030201ULL, 0x0706040503020100ULL,
+    0x0706030201000504ULL, 0x0706030201050400ULL, 0x0706030200050401ULL, 0x0706030205040100ULL,
+    0x0706030100050402ULL, 0x0706030105040200ULL, 0x0706030005040201ULL, 0x0706030504020100ULL,
+    0x0706020100050403ULL, 0x0706020105040300ULL, 0x0706020005040301ULL, 0x0706020504030100ULL,
+    0x0706010005040302ULL, 0x0706010504030200ULL, 0x0706000504030201ULL, 0x0706050403020100ULL,
+    0x0705040302010006ULL, 0x0705040302010600ULL, 0x0705040302000601ULL, 0x0705040302060100ULL,
+    0x0705040301000602ULL, 0x0705040301060200ULL, 0x0705040300060201ULL, 0x0705040306020100ULL,
+    0x0705040201000603ULL, 0x0705040201060300ULL, 0x0705040200060301ULL, 0x0705040206030100ULL,
+    0x0705040100060302ULL, 0x0705040106030200ULL, 0x0705040006030201ULL, 0x0705040603020100ULL,
+    0x0705030201000604ULL, 0x0705030201060400ULL, 0x0705030200060401ULL, 0x0705030206040100ULL,
+    0x0705030100060402ULL, 0x0705030106040200ULL, 0x0705030006040201ULL, 0x0705030604020100ULL,
+    0x0705020100060403ULL, 0x0705020106040300ULL, 0x0705020006040301ULL, 0x0705020604030100ULL,
+    0x0705010006040302ULL, 0x0705010604030200ULL, 0x0705000604030201ULL, 0x0705060403020100ULL,
+    0x0704030201000605ULL, 0x0704030201060500ULL, 0x0704030200060501ULL, 0x0704030206050100ULL,
+    0x0704030100060502ULL, 0x0704030106050200ULL, 0x0704030006050201ULL, 0x0704030605020100ULL,
+    0x0704020100060503ULL, 0x0704020106050300ULL, 0x0704020006050301ULL, 0x0704020605030100ULL,
+    0x0704010006050302ULL, 0x0704010605030200ULL, 0x0704000605030201ULL, 0x0704060503020100ULL,
+    0x0703020100060504ULL, 0x0703020106050400ULL, 0x0703020006050401ULL, 0x0703020605040100ULL,
+    0x0703010006050402ULL, 0x0703010605040200ULL, 0x0703000605040201ULL, 0x0703060504020100ULL,
+    0x0702010006050403ULL, 0x0702010605040300ULL, 0x0702000605040301ULL, 0x0702060504030100ULL,
+    0x0701000605040302ULL, 0x0701060504030200ULL, 0x0700060504030201ULL, 0x0706050403020100ULL,
+    0x0605040302010007ULL, 0x0605040302010700ULL, 0x0605040302000701ULL, 0x0605040302070100ULL,
+    0x0605040301000702ULL, 0x0605040301070200ULL, 0x0605040300070201ULL, 0x0605040307020100ULL,
+    0x0605040201000703ULL, 0x0605040201070300ULL, 0x0605040200070301ULL, 0x0605040207030100ULL,
+    0x0605040100070302ULL, 0x0605040107030200ULL, 0x0605040007030201ULL, 0x0605040703020100ULL,
+    0x0605030201000704ULL, 0x0605030201070400ULL, 0x0605030200070401ULL, 0x0605030207040100ULL,
+    0x0605030100070402ULL, 0x0605030107040200ULL, 0x0605030007040201ULL, 0x0605030704020100ULL,
+    0x0605020100070403ULL, 0x0605020107040300ULL, 0x0605020007040301ULL, 0x0605020704030100ULL,
+    0x0605010007040302ULL, 0x0605010704030200ULL, 0x0605000704030201ULL, 0x0605070403020100ULL,
+    0x0604030201000705ULL, 0x0604030201070500ULL, 0x0604030200070501ULL, 0x0604030207050100ULL,
+    0x0604030100070502ULL, 0x0604030107050200ULL, 0x0604030007050201ULL, 0x0604030705020100ULL,
+    0x0604020100070503ULL, 0x0604020107050300ULL, 0x0604020007050301ULL, 0x0604020705030100ULL,
+    0x0604010007050302ULL, 0x0604010705030200ULL, 0x0604000705030201ULL, 0x0604070503020100ULL,
+    0x0603020100070504ULL, 0x0603020107050400ULL, 0x0603020007050401ULL, 0x0603020705040100ULL,
+    0x0603010007050402ULL, 0x0603010705040200ULL, 0x0603000705040201ULL, 0x0603070504020100ULL,
+    0x0602010007050403ULL, 0x0602010705040300ULL, 0x0602000705040301ULL, 0x0602070504030100ULL,
+    0x0601000705040302ULL, 0x0601070504030200ULL, 0x0600070504030201ULL, 0x0607050403020100ULL,
+    0x0504030201000706ULL, 0x0504030201070600ULL, 0x0504030200070601ULL, 0x0504030207060100ULL,
+    0x0504030100070602ULL, 0x0504030107060200ULL, 0x0504030007060201ULL, 0x0504030706020100ULL,
+    0x0504020100070603ULL, 0x0504020107060300ULL, 0x0504020007060301ULL, 0x0504020706030100ULL,
+    0x0504010007060302ULL, 0x0504010706030200ULL, 0x0504000706030201ULL, 0x0504070603020100ULL,
+    0x0503020100070604ULL, 0x0503020107060400ULL, 0x0503020007060401ULL, 0x0503020706040100ULL,
+    0x0503010007060402ULL, 0x0503010706040200ULL, 0x0503000706040201ULL, 0x0503070604020100ULL,
+    0x0502010007060403ULL, 0x0502010706040300ULL, 0x0502000706040301ULL, 0x0502070604030100ULL,
+    0x0501000706040302ULL, 0x0501070604030200ULL, 0x0500070604030201ULL, 0x0507060403020100ULL,
+    0x0403020100070605ULL, 0x0403020107060500ULL, 0x0403020007060501ULL, 0x0403020706050100ULL,
+    0x0403010007060502ULL, 0x0403010706050200ULL, 0x0403000706050201ULL, 0x0403070605020100ULL,
+    0x0402010007060503ULL, 0x0402010706050300ULL, 0x0402000706050301ULL, 0x0402070605030100ULL,
+    0x0401000706050302ULL, 0x0401070605030200ULL, 0x0400070605030201ULL, 0x0407060503020100ULL,
+    0x0302010007060504ULL, 0x0302010706050400ULL, 0x0302000706050401ULL, 0x0302070605040100ULL,
+    0x0301000706050402ULL, 0x0301070605040200ULL, 0x0300070605040201ULL, 0x0307060504020100ULL,
+    0x0201000706050403ULL, 0x0201070605040300ULL, 0x0200070605040301ULL, 0x0207060504030100ULL,
+    0x0100070605040302ULL, 0x0107060504030200ULL, 0x0007060504030201ULL, 0x0706050403020100ULL
+};
+
+
+// Shuffles that join biski64_split8[low] (bytes 0..7) and biski64_split8[high] + 8 (bytes 8..15)
+// into the set positions of the 16-bit mask low | high << 8 followed by its clear positions,
+// indexed by the number of set bits k in low (the mask has 8 set bits in all).
+static const uint8_t biski64_merge16[9][16] = {
+    {  8,  9, 10, 11, 12, 13, 14, 15,  0,  1,  2,  3,  4,  5,  6,  7 },
+    {  0,  8,  9, 10, 11, 12, 13, 14,  1,  2,  3,  4,  5,  6,  7, 15 },
+    {  0,  1,  8,  9, 10, 11, 12, 13,  2,  3,  4,  5,  6,  7, 14, 15 },
+    {  0,  1,  2,  8,  9, 10, 11, 12,  3,  4,  5,  6,  7, 13, 14, 15 },
+    {  0,  1,  2,  3,  8,  9, 10, 11,  4,  5,  6,  7, 12, 13, 14, 15 },
+    {  0,  1,  2,  3,  4,  8,  9, 10,  5,  6,  7, 11, 12, 13, 14, 15 },
+    {  0,  1,  2,  3,  4,  5,  8,  9,  6,  7, 10, 11, 12, 13, 14, 15 },
+    {  0,  1,  2,  3,  4,  5,  6,  8,  7,  9, 10, 11, 12, 13, 14, 15 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 }
+};
+
+
+// The 8-element subsets of 16 positions grouped by how many fall in the low byte (k), with
+// C(8, k)^2 subsets in group k; group k starts at biski64_riffle16_start[k].
+static const uint16_t biski64_riffle16_start[10] = { 0, 1, 65, 849, 3985, 8885, 12021, 12805, 12869, 12870 };
+
+
+// ceil(2^64 / C(8, k)), so that q = (n * magic) >> 64 divides any n < 2^32 by C(8, k)
+// exactly (Lemire, Kaser and Kurz, "Faster Remainder by Direct Computation"). The entries for
+// C(8, k) = 1 are 0; there the only dividend is 0.
+static const uint64_t biski64_choose8_magic[9] = {
+    0x0000000000000000ULL, 0x2000000000000000ULL, 0x0924924924924925ULL,
+    0x0492492492492493ULL, 0x03A83A83A83A83A9ULL, 0x0492492492492493ULL,
+    0x0924924924924925ULL, 0x2000000000000000ULL, 0x0000000000000000ULL
+};
+
+#endif // BISKI64_PERMUTATION_TABLES_H
@@ -0,0 +1,887 @@
+#ifndef BISKI64_SHUFFLE_C
+#define BISKI64_SHUFFLE_C
+
+// Unity build
+#include "biski64.c"
+#include "biski64_permutation_tables.h"
+
+// Shuffles and permutations driven by the biski64 generators.
+
+
+/**
+ * @internal
+ * @brief Lemire's multiply-shift reduction of 32 given bits to [0, range), drawing the top
+ * 32 bits of fresh outputs in the rare case that the given bits must be rejected.
+ */
+static inline uint32_t biski64_shuffle_reduce(biski64_state* state, uint32_t bits, uint32_t range) {
+    uint64_t m = (uint64_t)bits * range;
+
+    if ((uint32_t)m < range) {
+        const uint32_t threshold = (0u - range) % range;
+        while ((uint32_t)m < threshold)
+            m = (biski64_next(state) >> 32) * range;
+    }
+
+    return (uint32_t)(m >> 32);
+}
+
+
+/**
+ * @internal
+ * @brief Swaps two elements of size bytes through a small stack buffer. With a constant
+ * size this compiles to plain loads and stores.
+ */
+static inline void biski64_swap_bytes(unsigned char* a, unsigned char* b, size_t size) {
+    unsigned char tmp[64];
+    while (size > 0) {
+        const size_t step = (size < sizeof(tmp)) ? size : sizeof(tmp);
+        memcpy(tmp, a, step);
+        memcpy(a, b, step);
+        memcpy(b, tmp, step);
+        a += step;
+        b += step;
+        size -= step;
+    }
+}
+
+
+/**
+ * @internal
+ * @brief Fisher-Yates driver shared by the public shuffles.
+ *
+ * Positions at or above 2^32 - 1 draw their swap targets one per output with
+ * biski64_bounded_u64(), so every range given to the paired loop fits in 32 bits. Below
+ * that, each output is split into two 32-bit halves that give the targets of two consecutive
+ * positions. The two reductions are independent multiplies, so they overlap in the pipeline,
+ * and each is rejected with probability below range / 2^32.
+ */
+static inline void biski64_shuffle_driver(biski64_state* state, unsigned char* a, size_t n, size_t size) {
+    size_t top = (n > 0) ? n - 1 : 0;
+
+    for (; (uint64_t)top >= UINT32_MAX; --top) {
+        const size_t j = (size_t)biski64_bounded_u64(state, (uint64_t)top + 1);
+        biski64_swap_bytes(a + top * size, a + j * size, size);
+    }
+
+    for (; top > 1; top -= 2) {
+        const uint64_t bits = biski64_next(state);
+        const size_t j0 = biski64_shuffle_reduce(state, (uint32_t)(bits >> 32), (uint32_t)top + 1);
+        const size_t j1 = biski64_shuffle_reduce(state, (uint32_t)bits, (uint32_t)top);
+        biski64_swap_bytes(a + top * size, a + j0 * size, size);
+        biski64_swap_bytes(a + (top - 1) * size, a + j1 * size, size);
+    }
+
+    if (top == 1) {
+        const size_t j = (size_t)(biski64_next(state) >> 63);
+        biski64_swap_bytes(a + size, a + j * size, size);
+    }
+}
+
+
+/**
+ * @brief Shuffles an array of 32-bit elements in place with Fisher-Yates.
+ *
+ * Each generator output supplies the swap targets of two positions, so a shuffle of n
+ * elements (n < 2^32) costs about n / 2 outputs and no divisions. Every permutation is
+ * equally likely.
+ *
+ * @param state Pointer to an initialized biski64_state structure.
+ * @param a     The array to shuffle.
+ * @param n     Number of elements.
+ */
+static void biski64_shuffle_u32(biski64_state* state, uint32_t* a, size_t n) {
+    biski64_shuffle_driver(state, (unsigned char*)a, n, sizeof(uint32_t));
+}
+
+
+/**
+ * @brief Shuffles an array of 64-bit elements in place. Same method as biski64_shuffle_u32().
+ */
+static void biski64_shuffle_u64(biski64_state* state, uint64_t* a, size_t n) {
+    biski64_shuffle_driver(state, (unsigned char*)a, n, sizeof(uint64_t));
+}
+
+
+/**
+ * @brief Shuffles an array of elements of any size in place. Same method and draws as
+ * biski64_shuffle_u32(), so a given state produces the same permutation for every element size.
+ *
+ * @param state Pointer to an initialized biski64_state structure.
+ * @param base  The array to shuffle.
+ * @param n     Number of elements.
+ * @param size  Size of each element in bytes.
+ */
+static void biski64_shuffle(biski64_state* state, void* base, size_t n, size_t size) {
+    biski64_shuffle_driver(state, (unsigned char*)base, n, size);
+}
+
+
+#ifndef BISKI64_DONT_USE_PARALLEL_STREAMS
+#ifdef _OPENMP
+#define BISKI64_PARALLEL_FOR _Pragma("omp parallel for schedule(static)")
+#define BISKI64_PARALLEL_FOR_DYNAMIC _Pragma("omp parallel for schedule(dynamic)")
+#else
+#define BISKI64_PARALLEL_FOR
+#define BISKI64_PARALLEL_FOR_DYNAMIC
+#endif
+
+
+/**
+ * @internal
+ * @brief log2 of the bytes per bucket that the parallel shuffle aims for, so that each
+ * bucket's Fisher-Yates pass runs in L2 cache.
+ */
+#define BISKI64_SCATTER_BUCKET_BYTES_LOG2 18
+
+
+/**
+ * @internal
+ * @brief Upper bound on log2 of the bucket count, which keeps the scatter's write streams
+ * within what the TLB and write-combining buffers can track.
+ */
+#define BISKI64_SCATTER_MAX_BUCKETS_LOG2 12
+
+
+/**
+ * @internal
+ * @brief Returns the first index of slice i when n elements are split into parts near-equal slices.
+ */
+static inline size_t biski64_part_begin(size_t n, int i, int parts) {
+    return n / parts * i + n % parts * i / parts;
+}
+
+
+/**
+ * @internal
+ * @brief Reads the next bucket label (the top log2_buckets bits of the remaining output),
+ * drawing a fresh output from state once the current one is used up.
+ */
+static inline size_t biski64_scatter_label(biski64_state* state, uint64_t* bits, int* left, int log2_buckets) {
+    if (*left == 0) {
+        *bits = biski64_next(state);
+        *left = 64 / log2_buckets;
+    }
+    const size_t label = (size_t)(*bits >> (64 - log2_buckets));
+    *bits <<= log2_buckets;
+    --*left;
+    return label;
+}
+
+
+/**
+ * @internal
+ * @brief Bucket-scatter shuffle with 2^log2_buckets buckets; see biski64_parallel_shuffle().
+ *
+ * Part i of the input (a contiguous slice) labels its elements with stream i of parts +
+ * buckets streams. A first pass only replays those labels to count them. A second pass
+ * scatters each element to the next free slot of its bucket in the scratch buffer, with
+ * the slots ordered by bucket and then by part. Bucket b is then shuffled with stream
+ * parts + b while it is in cache and copied back.
+ * i.i.d. uniform labels followed by a uniform order within each bucket give a uniform
+ * permutation. Every step depends only on seed, parts and log2_buckets, so the result is
+ * the same whichever thread runs it.
+ */
+static int biski64_scatter_shuffle(unsigned char* a, size_t n, size_t size, uint64_t seed, int parts, int log2_buckets) {
+    if (parts < 1)
+        parts = 1;
+    const int buckets = 1 << log2_buckets;
+    const int streams = parts + buckets;
+
+    if (log2_buckets == 0) {
+        biski64_state state;
+        biski64_stream(&state, seed, parts, streams);
+        biski64_shuffle_driver(&state, a, n, size);
+        return 0;
+    }
+
+    unsigned char* scratch = (unsigned char*)malloc(n * size);
+    size_t* slot = (size_t*)calloc((size_t)parts * buckets, sizeof(size_t));
+    size_t* start = (size_t*)malloc(((size_t)buckets + 1) * sizeof(size_t));
+    if (scratch == NULL || slot == NULL || start == NULL) {
+        free(scratch);
+        free(slot);
+        free(start);
+        return -1;
+    }
+
+    BISKI64_PARALLEL_FOR
+    for (int i = 0; i < parts; ++i) {
+        biski64_state state;
+        biski64_stream(&state, seed, i, streams);
+        size_t* count = slot + (size_t)i * buckets;
+        uint64_t bits = 0;
+        int left = 0;
+        for (size_t j = biski64_part_begin(n, i, parts), end = biski64_part_begin(n, i + 1, parts); j < end; ++j)
+            count[biski64_scatter_label(&state, &bits, &left, log2_buckets)]++;
+    }
+
+    size_t running = 0;
+    for (int b = 0; b < buckets; ++b) {
+        start[b] = running;
+        for (int i = 0; i < parts; ++i) {
+            const size_t count = slot[(size_t)i * buckets + b];
+            slot[(size_t)i * buckets + b] = running;
+            running += count;
+        }
+    }
+    start[buckets] = running;
+
+    BISKI64_PARALLEL_FOR
+    for (int i = 0; i < parts; ++i) {
+        biski64_state state;
+        biski64_stream(&state, seed, i, streams);
+        size_t* next = slot + (size_t)i * buckets;
+        uint64_t bits = 0;
+        int left = 0;
+        for (size_t j = biski64_part_begin(n, i, parts), end = biski64_part_begin(n, i + 1, parts); j < end; ++j) {
+            const size_t label = biski64_scatter_label(&state, &bits, &left, log2_buckets);
+            memcpy(scratch + next[label]++ * size, a + j * size, size);
+        }
+    }
+
+    BISKI64_PARALLEL_FOR_DYNAMIC
+    for (int b = 0; b < buckets; ++b) {
+        biski64_state state;
+        biski64_stream(&state, seed, parts + b, streams);
+        unsigned char* bucket = scratch + start[b] * size;
+        const size_t length = start[b + 1] - start[b];
+        biski64_shuffle_driver(&state, bucket, length, size);
+        memcpy(a + start[b] * size, bucket, length * size);
+    }
+
+    free(scratch);
+    free(slot);
+    free(start);
+    return 0;
+}
+
+
+/**
+ * @brief Shuffles a large array in place using parallel bucket scatter.
+ *
+ * The array is split into parts slices, and each slice is scattered into random
+ * cache-sized buckets. The buckets are then shuffled independently, each with its own
+ * biski64_stream() stream. Both phases are data-parallel. Built with -fopenmp they run on
+ * the OpenMP thread pool, and without it they run in order. The permutation is uniform.
+ * It depends only on seed, n, size and parts, not on how many threads actually run it.
+ *
+ * @param base  The array to shuffle.
+ * @param n     Number of elements.
+ * @param size  Size of each element in bytes.
+ * @param seed  Seed for the per-part and per-bucket streams.
+ * @param parts Number of input slices, normally the number of threads.
+ * @return 0 on success, or -1 if the n * size byte scratch buffer could not be allocated,
+ * in which case the array is unchanged.
+ */
+static int biski64_parallel_shuffle(void* base, size_t n, size_t size, uint64_t seed, int parts) {
+    int log2_buckets = 0;
+    while (log2_buckets < BISKI64_SCATTER_MAX_BUCKETS_LOG2 &&
+           ((n * size) >> log2_buckets) > ((size_t)1 << BISKI64_SCATTER_BUCKET_BYTES_LOG2))
+        ++log2_buckets;
+
+    return biski64_scatter_shuffle((unsigned char*)base, n, size, seed, parts, log2_buckets);
+}
+#endif // BISKI64_DONT_USE_PARALLEL_STREAMS
+
+
+/**
+ * @internal
+ * @brief Number of permutations of 16 elements, 16!.
+ */
+#define BISKI64_FACTORIAL16 20922789888000ULL
+
+
+/**
+ * @internal
+ * @brief Number of pairs of 8-element permutations, (8!)^2.
+ */
+#define BISKI64_FACTORIAL8_SQUARED 1625702400u
+
+
+/**
+ * @internal
+ * @brief Splits a rank u in [0, 8!) into the parts of a permutation of 8 elements.
+ *
+ * u / 576 picks which 4 positions form the first half (a byte with 4 set bits), and the two
+ * digits of u % 576 in base 24 order each half. Returns the split of that byte (see
+ * biski64_split8) and sets *order to the two half orders. Index t of the permutation is
+ * byte order[t] of the split. Every u gives a different permutation.
+ */
+static inline uint64_t biski64_perm8_parts(uint32_t u, uint64_t* order) {
+    const uint32_t subset = u / 576, within = u % 576;
+    *order = biski64_perm4[within / 24] | (uint64_t)(biski64_perm4[within % 24] + 0x04040404u) << 32;
+    return biski64_split8[biski64_bytes_by_weight[biski64_weight_start[4] + subset]];
+}
+
+
+/**
+ * @internal
+ * @brief Unranks s in [0, C(16, 8)) into an 8-of-16 subset. The subset is given as the splits
+ * of its low byte and its high byte (the latter offset by 8). Returns k, the number of set
+ * bits in the low byte, which selects the biski64_merge16 row.
+ */
+static inline int biski64_riffle16_parts(uint32_t s, uint64_t* low_split, uint64_t* high_split) {
+    int k = 0;
+    for (int i = 1; i <= 8; ++i)
+        k += (s >= biski64_riffle16_start[i]);
+
+    const uint32_t rem = s - biski64_riffle16_start[k];
+    const uint32_t choices = (uint32_t)(biski64_weight_start[k + 1] - biski64_weight_start[k]);
+    uint64_t lo;
+    const uint32_t a = (uint32_t)biski64_mul_hilo(rem, biski64_choose8_magic[k], &lo);
+    const uint32_t b = rem - a * choices;
+
+    *low_split  = biski64_split8[biski64_bytes_by_weight[biski64_weight_start[k] + a]];
+    *high_split = biski64_split8[biski64_bytes_by_weight[biski64_weight_start[8 - k] + b]] + 0x0808080808080808ULL;
+    return k;
+}
+
+
+/**
+ * @internal
+ * @brief Returns byte (order byte t) of table as byte t, for t < 8: the scalar form of pshufb.
+ */
+static inline uint64_t biski64_lookup8(uint64_t table, uint64_t order) {
+    uint64_t result = 0;
+    for (int t = 0; t < 8; ++t, order >>= 8)
+        result |= ((table >> ((order & 7) << 3)) & 0xFF) << (8 * t);
+    return result;
+}
+
+
+/**
+ * @internal
+ * @brief Writes the gather indices of a uniformly random permutation of n = 4, 8 or 16 elements.
+ *
+ * One bounded draw gives the rank of the permutation among all n!, apart from the rare
+ * rejection. For 4 elements the rank indexes biski64_perm4 directly. For 8 it is split by
+ * biski64_perm8_parts(). For 16 it is split into an 8-of-16 subset and two permutations of 8:
+ * the subset fills output positions in order, and each permutation orders one group.
+ */
+static void biski64_small_indices(biski64_state* state, size_t n, uint8_t* idx) {
+    if (n == 4) {
+        const uint32_t p = biski64_perm4[biski64_bounded_u64(state, 24)];
+        for (int t = 0; t < 4; ++t)
+            idx[t] = (uint8_t)(p >> (8 * t));
+        return;
+    }
+
+    if (n == 8) {
+        uint64_t order;
+        const uint64_t split = biski64_perm8_parts((uint32_t)biski64_bounded_u64(state, 40320), &order);
+        const uint64_t p = biski64_lookup8(split, order);
+        for (int t = 0; t < 8; ++t)
+            idx[t] = (uint8_t)(p >> (8 * t));
+        return;
+    }
+
+    const uint64_t r = biski64_bounded_u64(state, BISKI64_FACTORIAL16);
+    const uint32_t halves = (uint32_t)(r % BISKI64_FACTORIAL8_SQUARED);
+    uint64_t low_split, high_split, order_a, order_b;
+    const int k = biski64_riffle16_parts((uint32_t)(r / BISKI64_FACTORIAL8_SQUARED), &low_split, &high_split);
+    const uint64_t split_a = biski64_perm8_parts(halves / 40320, &order_a);
+    const uint64_t split_b = biski64_perm8_parts(halves % 40320, &order_b);
+
+    uint8_t joined[16], subset[16], order[16];
+    for (int t = 0; t < 8; ++t) {
+        joined[t]     = (uint8_t)(low_split >> (8 * t));
+        joined[t + 8] = (uint8_t)(high_split >> (8 * t));
+    }
+    for (int t = 0; t < 16; ++t)
+        subset[t] = joined[biski64_merge16[k][t]];
+
+    const uint64_t a = biski64_lookup8(split_a, order_a);
+    const uint64_t b = biski64_lookup8(split_b, order_b) + 0x0808080808080808ULL;
+    for (int t = 0; t < 8; ++t) {
+        order[t]     = (uint8_t)(a >> (8 * t));
+        order[t + 8] = (uint8_t)(b >> (8 * t));
+    }
+    for (int t = 0; t < 16; ++t)
+        idx[t] = subset[order[t]];
+}
+
+
+#ifdef BISKI64_X86_SIMD
+/**
+ * @internal
+ * @brief SSSE3/AVX2 implementation of biski64_small_indices() that returns the indices as the
+ * bytes of a register, with every lookup done by pshufb.
+ * The caller must ensure the CPU supports AVX2.
+ */
+__attribute__((target("avx2")))
+static inline __m128i biski64_small_indices_avx2(biski64_state* state, size_t n) {
+    if (n == 4)
+        return _mm_cvtsi32_si128((int)biski64_perm4[biski64_bounded_u64(state, 24)]);
+
+    if (n == 8) {
+        uint64_t order;
+        const uint64_t split = biski64_perm8_parts((uint32_t)biski64_bounded_u64(state, 40320), &order);
+        return _mm_shuffle_epi8(_mm_cvtsi64_si128((long long)split), _mm_cvtsi64_si128((long long)order));
+    }
+
+    const uint64_t r = biski64_bounded_u64(state, BISKI64_FACTORIAL16);
+    const uint32_t halves = (uint32_t)(r % BISKI64_FACTORIAL8_SQUARED);
+    uint64_t low_split, high_split, order_a, order_b;
+    const int k = biski64_riffle16_parts((uint32_t)(r / BISKI64_FACTORIAL8_SQUARED), &low_split, &high_split);
+    const uint64_t split_a = biski64_perm8_parts(halves / 40320, &order_a);
+    const uint64_t split_b = biski64_perm8_parts(halves % 40320, &order_b);
+
+    const __m128i subset = _mm_shuffle_epi8(_mm_set_epi64x((long long)high_split, (long long)low_split),
+                                            _mm_loadu_si128((const __m128i*)biski64_merge16[k]));
+    const __m128i a = _mm_shuffle_epi8(_mm_cvtsi64_si128((long long)split_a), _mm_cvtsi64_si128((long long)order_a));
+    const __m128i b = _mm_shuffle_epi8(_mm_cvtsi64_si128((long long)split_b), _mm_cvtsi64_si128((long long)order_b));
+    const __m128i order = _mm_unpacklo_epi64(a, _mm_add_epi8(b, _mm_set1_epi8(8)));
+    return _mm_shuffle_epi8(subset, order);
+}
+
+
+/**
+ * @internal
+ * @brief AVX2 body of biski64_shuffle_small_u32() for 4, 8 or 16 elements: vpermilps, vpermd,
+ * or two vpermd merged by blends. The caller must ensure the CPU supports AVX2.
+ */
+__attribute__((target("avx2")))
+static void biski64_shuffle_small_u32_avx2(biski64_state* state, uint32_t* a, size_t n) {
+    const __m128i idx = biski64_small_indices_avx2(state, n);
+
+    if (n == 4) {
+        const __m128 v = _mm_loadu_ps((const float*)a);
+        _mm_storeu_ps((float*)a, _mm_permutevar_ps(v, _mm_cvtepu8_epi32(idx)));
+        return;
+    }
+
+    const __m256i low = _mm256_loadu_si256((const __m256i*)a);
+    if (n == 8) {
+        _mm256_storeu_si256((__m256i*)a, _mm256_permutevar8x32_epi32(low, _mm256_cvtepu8_epi32(idx)));
+        return;
+    }
+
+    const __m256i high = _mm256_loadu_si256((const __m256i*)(a + 8));
+    const __m256i seven = _mm256_set1_epi32(7);
+    for (int o = 0; o < 2; ++o) {
+        const __m256i i = _mm256_cvtepu8_epi32(o == 0 ? idx : _mm_srli_si128(idx, 8));
+        const __m256i v = _mm256_blendv_epi8(_mm256_permutevar8x32_epi32(low, i), _mm256_permutevar8x32_epi32(high, i),
+                                             _mm256_cmpgt_epi32(i, seven));
+        _mm256_storeu_si256((__m256i*)(a + 8 * o), v);
+    }
+}
+
+
+/**
+ * @internal
+ * @brief AVX-512 body of biski64_shuffle_small_u32() for 16 elements: a single vpermd.
+ * The caller must ensure the CPU supports AVX-512F.
+ */
+__attribute__((target("avx512f")))
+static void biski64_shuffle_small_u32_avx512(biski64_state* state, uint32_t* a) {
+    const __m512i idx = _mm512_cvtepu8_epi32(biski64_small_indices_avx2(state, 16));
+    _mm512_storeu_si512(a, _mm512_permutexvar_epi32(idx, _mm512_loadu_si512(a)));
+}
+
+
+/**
+ * @internal
+ * @brief AVX2 body of biski64_shuffle_small_u8() for 4, 8 or 16 elements: one pshufb.
+ * The caller must ensure the CPU supports AVX2.
+ */
+__attribute__((target("avx2")))
+static void biski64_shuffle_small_u8_avx2(biski64_state* state, uint8_t* a, size_t n) {
+    const __m128i idx = biski64_small_indices_avx2(state, n);
+
+    if (n == 16) {
+        _mm_storeu_si128((__m128i*)a, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)a), idx));
+    } else if (n == 8) {
+        uint64_t v;
+        memcpy(&v, a, sizeof(v));
+        v = (uint64_t)_mm_cvtsi128_si64(_mm_shuffle_epi8(_mm_cvtsi64_si128((long long)v), idx));
+        memcpy(a, &v, sizeof(v));
+    } else {
+        uint32_t v;
+        memcpy(&v, a, sizeof(v));
+        v = (uint32_t)_mm_cvtsi128_si32(_mm_shuffle_epi8(_mm_cvtsi32_si128((int)v), idx));
+        memcpy(a, &v, sizeof(v));
+    }
+}
+#endif // BISKI64_X86_SIMD
+
+
+/**
+ * @brief Shuffles a small array of 32-bit elements in place.
+ *
+ * For 4, 8 and 16 elements the permutation comes from a single bounded draw (one output,
+ * apart from rare rejections). It is unranked through small tables and applied with one
+ * vector permute: vpermilps, vpermd, or on AVX-512 one 16-lane vpermd. There is no swap
+ * loop, and the result does not depend on the kernel in use. Every other size is shuffled
+ * by biski64_shuffle_u32().
+ *
+ * @param state Pointer to an initialized biski64_state structure.
+ * @param a     The array to shuffle.
+ * @param n     Number of elements.
+ */
+static void biski64_shuffle_small_u32(biski64_state* state, uint32_t* a, size_t n) {
+    if (n != 4 && n != 8 && n != 16) {
+        biski64_shuffle_driver(state, (unsigned char*)a, n, sizeof(uint32_t));
+        return;
+    }
+
+#ifdef BISKI64_X86_SIMD
+    if (n == 16 && biski64_kernel_in_use() == BISKI64_KERNEL_AVX512) {
+        biski64_shuffle_small_u32_avx512(state, a);
+        return;
+    }
+    if (biski64_kernel_in_use() != BISKI64_KERNEL_SCALAR) {
+        biski64_shuffle_small_u32_avx2(state, a, n);
+        return;
+    }
+#endif
+
+    uint8_t idx[16];
+    uint32_t copy[16];
+    biski64_small_indices(state, n, idx);
+    memcpy(copy, a, n * sizeof(uint32_t));
+    for (size_t t = 0; t < n; ++t)
+        a[t] = copy[idx[t]];
+}
+
+
+/**
+ * @brief Shuffles a small array of bytes (for example a hand of card codes) in place.
+ * Uses the same method and the same permutation as biski64_shuffle_small_u32(), applied with pshufb.
+ *
+ * @param state Pointer to an initialized biski64_state structure.
+ * @param a     The array to shuffle.
+ * @param n     Number of elements.
+ */
+static void biski64_shuffle_small_u8(biski64_state* state, uint8_t* a, size_t n) {
+    if (n != 4 && n != 8 && n != 16) {
+        biski64_shuffle_driver(state, a, n, 1);
+        return;
+    }
+
+#ifdef BISKI64_X86_SIMD
+    if (biski64_kernel_in_use() != BISKI64_KERNEL_SCALAR) {
+        biski64_shuffle_small_u8_avx2(state, a, n);
+        return;
+    }
+#endif
+
+    uint8_t idx[16], copy[16];
+    biski64_small_indices(state, n, idx);
+    memcpy(copy, a, n);
+    for (size_t t = 0; t < n; ++t)
+        a[t] = copy[idx[t]];
+}
+
+
+/**
+ * @internal
+ * @brief Number of Feistel rounds. Must be even so the two half widths end where they started.
+ */
+#define BISKI64_FEISTEL_ROUNDS 6
+
+
+/**
+ * @brief A keyed pseudo-random permutation of [0, n), evaluated without storing it.
+ *
+ * Initialize with biski64_feistel_init(). The structure is read-only afterwards, so it can be
+ * shared between threads.
+ */
+typedef struct {
+    uint64_t n;                                ///< Size of the permuted range.
+    int left_bits;                             ///< Width of the high half of an index.
+    int right_bits;                            ///< Width of the low half of an index.
+    uint32_t left_mask;                        ///< (1 << left_bits) - 1.
+    uint32_t right_mask;                       ///< (1 << right_bits) - 1.
+    uint32_t keys[BISKI64_FEISTEL_ROUNDS];     ///< Round keys.
+} biski64_feistel;
+
+
+/**
+ * @internal
+ * @brief The Feistel round function: a 32-bit avalanche mixer (Wellons' "lowbias32").
+ */
+static inline uint32_t biski64_feistel_mix(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+
+/**
+ * @brief Initializes a permutation of [0, n) keyed by seed.
+ *
+ * An index is split into a high half of floor(b / 2) bits and a low half of ceil(b / 2) bits,
+ * where b is the bit length of n - 1, so the Feistel network permutes [0, 2^b). That range is
+ * less than twice n. The round keys are drawn from a biski64 generator seeded with seed, so
+ * each seed (for example one per epoch) gives an independent permutation.
+ *
+ * @param perm Pointer to the structure to initialize.
+ * @param n    Size of the range. The caller must ensure n >= 1.
+ * @param seed Key for the permutation.
+ */
+static void biski64_feistel_init(biski64_feistel* perm, uint64_t n, uint64_t seed) {
+    const int bits = (n > 1) ? 64 - biski64_clz64(n - 1) : 0;
+
+    perm->n = n;
+    perm->left_bits  = bits / 2;
+    perm->right_bits = bits - bits / 2;
+    perm->left_mask  = (uint32_t)(((uint64_t)1 << perm->left_bits) - 1);
+    perm->right_mask = (uint32_t)(((uint64_t)1 << perm->right_bits) - 1);
+
+    biski64_state state;
+    biski64_seed(&state, seed);
+    for (int i = 0; i < BISKI64_FEISTEL_ROUNDS; ++i)
+        perm->keys[i] = (uint32_t)(biski64_next(&state) >> 32);
+}
+
+
+/**
+ * @internal
+ * @brief Applies the Feistel network to x in [0, 2^b).
+ *
+ * The halves alternate in width as in NIST FF1: even rounds update a left_bits-wide half and
+ * odd rounds a right_bits-wide one, which makes the network a bijection even when b is odd.
+ */
+static inline uint64_t biski64_feistel_encrypt(const biski64_feistel* perm, uint64_t x) {
+    uint32_t a = (uint32_t)(x >> perm->right_bits);
+    uint32_t b = (uint32_t)x & perm->right_mask;
+
+    for (int i = 0; i < BISKI64_FEISTEL_ROUNDS; ++i) {
+        const uint32_t mask = (i & 1) ? perm->right_mask : perm->left_mask;
+        const uint32_t c = a ^ (biski64_feistel_mix(b ^ perm->keys[i]) & mask);
+        a = b;
+        b = c;
+    }
+
+    return (uint64_t)a << perm->right_bits | b;
+}
+
+
+/**
+ * @internal
+ * @brief Inverts biski64_feistel_encrypt().
+ */
+static inline uint64_t biski64_feistel_decrypt(const biski64_feistel* perm, uint64_t y) {
+    uint32_t a = (uint32_t)(y >> perm->right_bits);
+    uint32_t b = (uint32_t)y & perm->right_mask;
+
+    for (int i = BISKI64_FEISTEL_ROUNDS - 1; i >= 0; --i) {
+        const uint32_t mask = (i & 1) ? perm->right_mask : perm->left_mask;
+        const uint32_t c = b ^ (biski64_feistel_mix(a ^ perm->keys[i]) & mask);
+        b = a;
+        a = c;
+    }
+
+    return (uint64_t)a << perm->right_bits | b;
+}
+
+
+/**
+ * @brief Returns element i of the permutation in O(1) time and memory.
+ *
+ * Values of the network that fall in [n, 2^b) are passed through it again (cycle walking)
+ * until one lands in [0, n). This takes fewer than two passes on average.
+ *
+ * @param perm Pointer to an initialized biski64_feistel structure.
+ * @param i    Position in the permutation. The caller must ensure i < n.
+ * @return The element at position i, in [0, n).
+ */
+static inline uint64_t biski64_feistel_at(const biski64_feistel* perm, uint64_t i) {
+    uint64_t x = i;
+    do {
+        x = biski64_feistel_encrypt(perm, x);
+    } while (x >= perm->n);
+    return x;
+}
+
+
+/**
+ * @brief Returns the position of value in the permutation: biski64_feistel_at(perm, i) == value.
+ *
+ * @param perm  Pointer to an initialized biski64_feistel structure.
+ * @param value An element of [0, n).
+ * @return Its position in [0, n).
+ */
+static inline uint64_t biski64_feistel_position(const biski64_feistel* perm, uint64_t value) {
+    uint64_t x = value;
+    do {
+        x = biski64_feistel_decrypt(perm, x);
+    } while (x >= perm->n);
+    return x;
+}
+
+
+#ifdef BISKI64_X86_SIMD
+/**
+ * @internal
+ * @brief Packs the low 32 bits of the four 64-bit lanes of x0 and then of x1 into one register.
+ */
+__attribute__((target("avx2")))
+static inline __m256i biski64_pack_low32_avx2(__m256i x0, __m256i x1) {
+    const __m256i pick = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    return _mm256_permute2x128_si256(_mm256_permutevar8x32_epi32(x0, pick), _mm256_permutevar8x32_epi32(x1, pick), 0x20);
+}
+
+
+/**
+ * @internal
+ * @brief AVX2 implementation of biski64_feistel_fill() for eight positions at a time, with the
+ * 32-bit halves of the eight indices in two registers. Lanes that need another pass of cycle
+ * walking run the network again, and the lanes already in range are kept by blends.
+ * The caller must ensure the CPU supports AVX2.
+ */
+__attribute__((target("avx2")))
+static void biski64_feistel_fill_avx2(const biski64_feistel* perm, uint64_t start, uint64_t* out, size_t count) {
+    const __m128i shift = _mm_cvtsi32_si128(perm->right_bits);
+    const __m256i low_mask64 = _mm256_set1_epi64x((long long)perm->right_mask);
+    const __m256i sign = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+    const __m256i limit = _mm256_xor_si256(_mm256_set1_epi64x((long long)perm->n), sign);
+    __m256i mask[2], key[BISKI64_FEISTEL_ROUNDS];
+    mask[0] = _mm256_set1_epi32((int)perm->left_mask);
+    mask[1] = _mm256_set1_epi32((int)perm->right_mask);
+    for (int i = 0; i < BISKI64_FEISTEL_ROUNDS; ++i)
+        key[i] = _mm256_set1_epi32((int)perm->keys[i]);
+
+    size_t j = 0;
+    for (; j + 8 <= count; j += 8) {
+        const __m256i base = _mm256_set1_epi64x((long long)(start + j));
+        const __m256i x0 = _mm256_add_epi64(base, _mm256_setr_epi64x(0, 1, 2, 3));
+        const __m256i x1 = _mm256_add_epi64(base, _mm256_setr_epi64x(4, 5, 6, 7));
+        __m256i a = biski64_pack_low32_avx2(_mm256_srl_epi64(x0, shift), _mm256_srl_epi64(x1, shift));
+        __m256i b = biski64_pack_low32_avx2(_mm256_and_si256(x0, low_mask64), _mm256_and_si256(x1, low_mask64));
+        __m256i pending = _mm256_set1_epi32(-1);
+        __m256i y0, y1;
+
+        for (;;) {
+            __m256i na = a, nb = b;
+            for (int i = 0; i < BISKI64_FEISTEL_ROUNDS; ++i) {
+                __m256i f = _mm256_xor_si256(nb, key[i]);
+                f = _mm256_xor_si256(f, _mm256_srli_epi32(f, 16));
+                f = _mm256_mullo_epi32(f, _mm256_set1_epi32(0x7FEB352D));
+                f = _mm256_xor_si256(f, _mm256_srli_epi32(f, 15));
+                f = _mm256_mullo_epi32(f, _mm256_set1_epi32((int)0x846CA68Bu));
+                f = _mm256_xor_si256(f, _mm256_srli_epi32(f, 16));
+                const __m256i c = _mm256_xor_si256(na, _mm256_and_si256(f, mask[i & 1]));
+                na = nb;
+                nb = c;
+            }
+            a = _mm256_blendv_epi8(a, na, pending);
+            b = _mm256_blendv_epi8(b, nb, pending);
+
+            y0 = _mm256_or_si256(_mm256_sll_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(a)), shift),
+                                 _mm256_cvtepu32_epi64(_mm256_castsi256_si128(b)));
+            y1 = _mm256_or_si256(_mm256_sll_epi64(_mm256_cvtepu32_epi64(_mm256_extracti128_si256(a, 1)), shift),
+                                 _mm256_cvtepu32_epi64(_mm256_extracti128_si256(b, 1)));
+            const __m256i in_range = biski64_pack_low32_avx2(
+                _mm256_cmpgt_epi64(limit, _mm256_xor_si256(y0, sign)), _mm256_cmpgt_epi64(limit, _mm256_xor_si256(y1, sign)));
+            pending = _mm256_andnot_si256(in_range, pending);
+            if (_mm256_testz_si256(pending, pending))
+                break;
+        }
+
+        _mm256_storeu_si256((__m256i*)(out + j), y0);
+        _mm256_storeu_si256((__m256i*)(out + j + 4), y1);
+    }
+
+    for (; j < count; ++j)
+        out[j] = biski64_feistel_at(perm, start + j);
+}
+
+
+/**
+ * @internal
+ * @brief AVX-512 implementation of biski64_feistel_fill() for sixteen positions at a time.
+ * The caller must ensure the CPU supports AVX-512F.
+ */
+__attribute__((target("avx512f")))
+static void biski64_feistel_fill_avx512(const biski64_feistel* perm, uint64_t start, uint64_t* out, size_t count) {
+    const __m128i shift = _mm_cvtsi32_si128(perm->right_bits);
+    const __m512i low_mask64 = _mm512_set1_epi64((long long)perm->right_mask);
+    const __m512i limit = _mm512_set1_epi64((long long)perm->n);
+    const __m512i step = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+    __m512i mask[2], key[BISKI64_FEISTEL_ROUNDS];
+    mask[0] = _mm512_set1_epi32((int)perm->left_mask);
+    mask[1] = _mm512_set1_epi32((int)perm->right_mask);
+    for (int i = 0; i < BISKI64_FEISTEL_ROUNDS; ++i)
+        key[i] = _mm512_set1_epi32((int)perm->keys[i]);
+
+    size_t j = 0;
+    for (; j + 16 <= count; j += 16) {
+        const __m512i x0 = _mm512_add_epi64(_mm512_set1_epi64((long long)(start + j)), step);
+        const __m512i x1 = _mm512_add_epi64(_mm512_set1_epi64((long long)(start + j + 8)), step);
+        __m512i a = _mm512_inserti64x4(_mm512_castsi256_si512(_mm512_cvtepi64_epi32(_mm512_srl_epi64(x0, shift))),
+                                       _mm512_cvtepi64_epi32(_mm512_srl_epi64(x1, shift)), 1);
+        __m512i b = _mm512_inserti64x4(_mm512_castsi256_si512(_mm512_cvtepi64_epi32(_mm512_and_si512(x0, low_mask64))),
+                                       _mm512_cvtepi64_epi32(_mm512_and_si512(x1, low_mask64)), 1);
+        __mmask16 pending = 0xFFFF;
+        __m512i y0, y1;
+
+        for (;;) {
+            __m512i na = a, nb = b;
+            for (int i = 0; i < BISKI64_FEISTEL_ROUNDS; ++i) {
+                __m512i f = _mm512_xor_si512(nb, key[i]);
+                f = _mm512_xor_si512(f, _mm512_srli_epi32(f, 16));
+                f = _mm512_mullo_epi32(f, _mm512_set1_epi32(0x7FEB352D));
+                f = _mm512_xor_si512(f, _mm512_srli_epi32(f, 15));
+                f = _mm512_mullo_epi32(f, _mm512_set1_epi32((int)0x846CA68Bu));
+                f = _mm512_xor_si512(f, _mm512_srli_epi32(f, 16));
+                const __m512i c = _mm512_xor_si512(na, _mm512_and_si512(f, mask[i & 1]));
+                na = nb;
+                nb = c;
+            }
+            a = _mm512_mask_mov_epi32(a, pending, na);
+            b = _mm512_mask_mov_epi32(b, pending, nb);
+
+            y0 = _mm512_or_si512(_mm512_sll_epi64(_mm512_cvtepu32_epi64(_mm512_castsi512_si256(a)), shift),
+                                 _mm512_cvtepu32_epi64(_mm512_castsi512_si256(b)));
+            y1 = _mm512_or_si512(_mm512_sll_epi64(_mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(a, 1)), shift),
+                                 _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(b, 1)));
+            const __mmask16 in_range = (__mmask16)(_mm512_cmplt_epu64_mask(y0, limit) |
+                                                   (unsigned)_mm512_cmplt_epu64_mask(y1, limit) << 8);
+            pending = (__mmask16)(pending & ~in_range);
+            if (pending == 0)
+                break;
+        }
+
+        _mm512_storeu_si512(out + j, y0);
+        _mm512_storeu_si512(out + j + 8, y1);
+    }
+
+    for (; j < count; ++j)
+        out[j] = biski64_feistel_at(perm, start + j);
+}
+#endif // BISKI64_X86_SIMD
+
+
+/**
+ * @brief Writes elements start, start + 1, ..., start + count - 1 of the permutation.
+ *
+ * The AVX2 and AVX-512 tiers run the network on 8 or 16 positions at once, using 32-bit
+ * lanes for the halves. The output is the same as calling biski64_feistel_at() for each
+ * position.
+ *
+ * @param perm  Pointer to an initialized biski64_feistel structure.
+ * @param start First position. The caller must ensure start + count <= n.
+ * @param out   Destination buffer with room for count values.
+ * @param count Number of positions to evaluate.
+ */
+static void biski64_feistel_fill(const biski64_feistel* perm, uint64_t start, uint64_t* out, size_t count) {
+#ifdef BISKI64_X86_SIMD
+    if (biski64_kernel_in_use() == BISKI64_KERNEL_AVX512) {
+        biski64_feistel_fill_avx512(perm, start, out, count);
+        return;
+    }
+    if (biski64_kernel_in_use() == BISKI64_KERNEL_AVX2) {
+        biski64_feistel_fill_avx2(perm, start, out, count);
+        return;
+    }
+#endif
+
+    for (size_t j = 0; j < count; ++j)
+        out[j] = biski64_feistel_at(perm, start + j);
+}
+
+#endif // BISKI64_SHUFFLE_C
@@ -0,0 +1,1500 @@
+#include <math.h>   // For fabs, sqrt
+#include <stdint.h> // For uint64_t and standard integer types
+#include <stdio.h>  // For printf
+#include <string.h> // For memcmp
+
+// Unity build
+#include "biski64.c"
+#include "biski64_dist.c"
+#include "biski64_shuffle.c"
+
+// Build and run:
+//   gcc -O2 -o biski64_test biski64_test.c -lm && ./biski64_test
+//   gcc -O2 -march=native -o biski64_test biski64_test.c -lm && ./biski64_test
+
+
+static int failures = 0;
+
+#define CHECK(cond, name)                                   \
+    do {                                                    \
+        if (cond) {                                         \
+            printf("  PASS: %s\n", name);                   \
+        } else {                                            \
+            printf("  FAIL: %s\n", name);                   \
+            failures++;                                     \
+        }                                                   \
+    } while (0)
+
+
+/**
+ * @brief Checks that lane k of a biski64x4 engine reproduces scalar stream k,
+ * including across calls whose length is not a multiple of the lane count.
+ */
+static void test_x4_lanes_match_scalar_streams(void) {
+    enum { STEPS = 1000 };
+    const uint64_t seed = 0x243F6A8885A308D9ULL;
+
+    biski64_state scalar[4];
+    for (int k = 0; k < 4; ++k)
+        biski64_stream(&scalar[k], seed, k, 4);
+
+    biski64x4_state x4;
+    biski64x4_seed(&x4, seed);
+
+    // Element j of each call comes from lane (j % 4), and a short final step leaves the
+    // remaining lanes untouched, so every lane stays gap-free across calls.
+    static uint64_t out[4 * STEPS];
+    const size_t lengths[3] = { 4 * STEPS - 7, 7, 4 * STEPS };
+
+    int ok = 1;
+    for (int c = 0; c < 3; ++c) {
+        biski64x4_fill(&x4, out, lengths[c]);
+        for (size_t j = 0; j < lengths[c]; ++j)
+            ok &= (out[j] == biski64_next(&scalar[j % 4]));
+    }
+
+    CHECK(ok, "biski64x4 lane k matches biski64_stream(seed, k, 4)");
+
+}
+
+
+/**
+ * @brief Checks that lane k of a biski64x8 engine reproduces scalar stream k.
+ */
+static void test_x8_lanes_match_scalar_streams(void) {
+    enum { STEPS = 1000 };
+    const uint64_t seed = 0xB7E151628AED2A6AULL;
+
+    biski64_state scalar[8];
+    for (int k = 0; k < 8; ++k)
+        biski64_stream(&scalar[k], seed, k, 8);
+
+    biski64x8_state x8;
+    biski64x8_seed(&x8, seed);
+
+    static uint64_t out[8 * STEPS];
+    const size_t lengths[3] = { 8 * STEPS - 5, 13, 8 * STEPS };
+
+    int ok = 1;
+    for (int c = 0; c < 3; ++c) {
+        biski64x8_fill(&x8, out, lengths[c]);
+        for (size_t j = 0; j < lengths[c]; ++j)
+            ok &= (out[j] == biski64_next(&scalar[j % 8]));
+    }
+
+    CHECK(ok, "biski64x8 lane k matches biski64_stream(seed, k, 8)");
+
+}
+
+
+/**
+ * @brief Checks that every kernel tier this CPU can run is bit-exact with the scalar tier.
+ */
+static void test_kernel_tiers_match_scalar(void) {
+    enum { N = 8 * 1000 + 5 };
+    static uint64_t ref[N], out[N];
+
+    printf("  (bound kernel: %s)\n", biski64_kernel_name());
+
+    biski64x4_state x4;
+    biski64x8_state x8;
+    biski64x4_seed(&x4, 99);
+    biski64x4_fill_scalar(&x4, ref, N);
+
+    int ok4 = 1;
+    for (int t = 0; t <= (int)biski64_kernel_in_use(); ++t) {
+        biski64x4_seed(&x4, 99);
+        biski64_kernel_tables[t].fill_x4(&x4, out, N);
+        ok4 &= (memcmp(ref, out, sizeof(ref)) == 0);
+    }
+
+    biski64x8_seed(&x8, 99);
+    biski64x8_fill_scalar(&x8, ref, N);
+
+    int ok8 = 1;
+    for (int t = 0; t <= (int)biski64_kernel_in_use(); ++t) {
+        biski64x8_seed(&x8, 99);
+        biski64_kernel_tables[t].fill_x8(&x8, out, N);
+        ok8 &= (memcmp(ref, out, sizeof(ref)) == 0);
+    }
+
+    CHECK(ok4, "biski64x4 kernels up to the bound tier match the scalar kernel");
+    CHECK(ok8, "biski64x8 kernels up to the bound tier match the scalar kernel");
+}
+
+
+/**
+ * @brief Checks the documented output order of biski64_fill_u64(), including tails.
+ */
+static void test_fill_u64_matches_x4(void) {
+    enum { N = 4001 };
+    const uint64_t seed = 0x6A09E667F3BCC908ULL;
+
+    biski64_state states[BISKI64_FILL_LANES];
+    for (int k = 0; k < BISKI64_FILL_LANES; ++k)
+        biski64_stream(&states[k], seed, k, BISKI64_FILL_LANES);
+
+    biski64x4_state x4;
+    biski64x4_seed(&x4, seed);
+
+    static uint64_t a[N], b[N];
+    int ok = 1;
+    for (size_t n = 0; n <= 9; ++n) {
+        biski64_fill_u64(states, a, N - n);
+        biski64x4_fill(&x4, b, N - n);
+        ok &= (memcmp(a, b, (N - n) * sizeof(uint64_t)) == 0);
+    }
+
+    CHECK(ok, "biski64_fill_u64 matches biski64x4_fill for every tail length");
+}
+
+
+/**
+ * @brief Checks that biski64_fill_bytes() produces the same bytes on the cached and
+ * non-temporal paths for every head alignment and tail length.
+ */
+static void test_fill_bytes_nontemporal_matches_cached(void) {
+    static uint8_t a[4096 + 64], b[4096 + 64];
+    int ok = 1;
+
+    for (size_t offset = 0; offset < 16; ++offset) {
+        for (size_t len = 4000; len < 4100 - offset; len += 7) {
+            biski64_state sa, sb;
+            biski64_seed(&sa, 1000 + len);
+            biski64_seed(&sb, 1000 + len);
+
+            biski64_set_nontemporal_threshold(SIZE_MAX);
+            biski64_fill_bytes(&sa, a + offset, len);
+            biski64_set_nontemporal_threshold(0);
+            biski64_fill_bytes(&sb, b + offset, len);
+
+            ok &= (memcmp(a + offset, b + offset, len) == 0);
+            ok &= (biski64_next(&sa) == biski64_next(&sb));
+        }
+    }
+    biski64_set_nontemporal_threshold(BISKI64_NONTEMPORAL_THRESHOLD_DEFAULT);
+
+    CHECK(ok, "biski64_fill_bytes streaming path matches cached path");
+
+    biski64_state s, ref;
+    biski64_seed(&s, 7);
+    biski64_seed(&ref, 7);
+    uint8_t small[11];
+    biski64_fill_bytes(&s, small, sizeof(small));
+    const uint64_t w0 = biski64_next(&ref), w1 = biski64_next(&ref);
+
+    int layout_ok = 1;
+    for (int i = 0; i < 8; ++i)
+        layout_ok &= (small[i] == (uint8_t)(w0 >> (8 * i)));
+    for (int i = 0; i < 3; ++i)
+        layout_ok &= (small[8 + i] == (uint8_t)(w1 >> (32 + 8 * i)));
+
+    CHECK(layout_ok, "biski64_fill_bytes uses little-endian outputs and the high half for short tails");
+}
+
+
+/**
+ * @brief Checks the documented sequence of biski64_buffered_next() across several refills.
+ */
+static void test_buffered_sequence(void) {
+    const uint64_t seed = 0xBB67AE8584CAA73BULL;
+
+    biski64_state scalar[8];
+    for (int k = 0; k < 8; ++k)
+        biski64_stream(&scalar[k], seed, k, 8);
+
+    biski64_buffered gen;
+    biski64_buffered_seed(&gen, seed);
+
+    int ok = 1;
+    for (int i = 0; i < 5 * BISKI64_BUFFER_SIZE + 3; ++i)
+        ok &= (biski64_buffered_next(&gen) == biski64_next(&scalar[i % 8]));
+
+    CHECK(ok, "biski64_buffered output i is value i / 8 of biski64_stream(seed, i % 8, 8)");
+}
+
+
+/**
+ * @brief Checks that 32-bit draws use both halves of each output and that
+ * biski64_fill_u32() continues the biski64_next_u32() sequence.
+ */
+static void test_u32_draws_use_both_halves(void) {
+    biski64_u32_state a, b;
+    biski64_state ref;
+    biski64_u32_seed(&a, 2024);
+    biski64_u32_seed(&b, 2024);
+    biski64_seed(&ref, 2024);
+
+    int ok = 1;
+    for (int i = 0; i < 100; ++i) {
+        const uint64_t output = biski64_next(&ref);
+        ok &= (biski64_next_u32(&a) == (uint32_t)output);
+        ok &= (biski64_next_u32(&a) == (uint32_t)(output >> 32));
+    }
+    CHECK(ok, "biski64_next_u32 returns the low then the high half of each output");
+
+    biski64_u32_seed(&a, 2024);
+
+    uint32_t filled[64];
+    int fill_ok = 1;
+    for (size_t n = 0; n < 12; ++n) {
+        biski64_fill_u32(&b, filled, n);
+        for (size_t i = 0; i < n; ++i)
+            fill_ok &= (filled[i] == biski64_next_u32(&a));
+    }
+    CHECK(fill_ok, "biski64_fill_u32 matches repeated biski64_next_u32 for odd and even counts");
+
+    int stream_ok = 1;
+    for (int k = 0; k < 4; ++k) {
+        biski64_u32_stream(&a, 2024, k, 4);
+        biski64_stream(&ref, 2024, k, 4);
+        for (int i = 0; i < 100; ++i) {
+            const uint64_t output = biski64_next(&ref);
+            stream_ok &= (biski64_next_u32(&a) == (uint32_t)output);
+            stream_ok &= (biski64_next_u32(&a) == (uint32_t)(output >> 32));
+        }
+    }
+    CHECK(stream_ok, "biski64_u32_stream(seed, k, n) splits the outputs of biski64_stream(seed, k, n)");
+}
+
+
+/**
+ * @brief Checks that variable-width bit requests read the output stream in order.
+ */
+static void test_bit_reservoir(void) {
+    biski64_bits_state bits;
+    biski64_state ref;
+    biski64_bits_seed(&bits, 31337);
+    biski64_seed(&ref, 31337);
+
+    // Reference: read the concatenated outputs one bit at a time.
+    uint64_t word = 0;
+    unsigned left = 0;
+
+    int ok = 1;
+    for (int i = 0; i < 5000; ++i) {
+        const unsigned k = (i % 3 == 0) ? 1u : 1u + (unsigned)((uint64_t)i * 0x9E3779B97F4A7C15ULL >> 58);
+        const uint64_t got = (i % 3 == 0) ? (uint64_t)biski64_next_bool(&bits) : biski64_next_bits(&bits, k);
+
+        uint64_t expected = 0;
+        for (unsigned b = 0; b < k; ++b) {
+            if (left == 0) {
+                word = biski64_next(&ref);
+                left = 64;
+            }
+            expected |= (word & 1) << b;
+            word >>= 1;
+            left--;
+        }
+        ok &= (got == expected);
+    }
+    CHECK(ok, "biski64_next_bits and biski64_next_bool read outputs least significant bit first");
+
+    biski64_bits_state streamed;
+    int stream_ok = 1;
+    for (int k = 0; k < 4; ++k) {
+        biski64_bits_stream(&streamed, 31337, k, 4);
+        biski64_stream(&ref, 31337, k, 4);
+        for (int i = 0; i < 100; ++i) {
+            const uint64_t output = biski64_next(&ref);
+            stream_ok &= (biski64_next_bits(&streamed, 24) == (output & 0xFFFFFF));
+            stream_ok &= (biski64_next_bits(&streamed, 40) == output >> 24);
+        }
+    }
+    CHECK(stream_ok, "biski64_bits_stream(seed, k, n) reads the outputs of biski64_stream(seed, k, n)");
+
+    biski64x8_state a, b;
+    biski64x8_seed(&a, 5);
+    biski64x8_seed(&b, 5);
+    uint64_t bitmap[4], words[4];
+    biski64x8_fill_bits(&a, bitmap, 200);
+    biski64x8_fill(&b, words, 4);
+
+    CHECK(bitmap[0] == words[0] && bitmap[2] == words[2] && bitmap[3] == (words[3] & 0xFF),
+          "biski64x8_fill_bits uses engine outputs and clears bits past nbits");
+}
+
+
+/**
+ * @brief Checks range, rough uniformity and kernel independence of bounded integers.
+ */
+static void test_bounded_integers(void) {
+    biski64_state state;
+    biski64_seed(&state, 4242);
+
+    int counts[6] = { 0 };
+    int in_range = 1;
+    for (int i = 0; i < 60000; ++i) {
+        const uint32_t a = biski64_bounded_u32(&state, 6);
+        const uint64_t b = biski64_bounded_u64(&state, 0xFFFFFFFFFFFFFFF0ULL);
+        in_range &= (a < 6) && (b < 0xFFFFFFFFFFFFFFF0ULL) && (biski64_bounded_u64(&state, 1) == 0);
+        counts[a < 6 ? a : 0]++;
+    }
+
+    int uniform = 1;
+    for (int v = 0; v < 6; ++v)
+        uniform &= (counts[v] > 9500 && counts[v] < 10500);
+
+    CHECK(in_range, "biski64_bounded_u32/u64 stay in [0, range)");
+    CHECK(uniform, "biski64_bounded_u32 is roughly uniform over a small range");
+
+    enum { N = 10007 };
+    static uint32_t batch32[N];
+    static uint64_t batch64[N];
+    biski64x8_state x8;
+    biski64x8_seed(&x8, 17);
+    biski64x8_fill_bounded_u32(&x8, batch32, N, 3000000000u);
+    biski64x8_fill_bounded_u64(&x8, batch64, N, 1000);
+
+    int batch_ok = 1;
+    for (int i = 0; i < N; ++i)
+        batch_ok &= (batch32[i] < 3000000000u) && (batch64[i] < 1000);
+    CHECK(batch_ok, "biski64x8_fill_bounded_u32/u64 stay in [0, range)");
+
+#ifdef BISKI64_X86_SIMD
+    if (biski64_kernel_in_use() == BISKI64_KERNEL_AVX512) {
+        static uint64_t raw[4 * BISKI64_BATCH_CHUNK];
+        static uint32_t a[8 * BISKI64_BATCH_CHUNK + 16], b[8 * BISKI64_BATCH_CHUNK + 16];
+        biski64x8_fill(&x8, raw, 4 * BISKI64_BATCH_CHUNK);
+
+        const uint32_t range = 3000000000u, threshold = (0 - range) % range;
+        const size_t ka = biski64_bounded_compact_u32(raw, 4 * BISKI64_BATCH_CHUNK - 3, range, threshold, a);
+        const size_t kb = biski64_bounded_compact_u32_avx512(raw, 4 * BISKI64_BATCH_CHUNK - 3, range, threshold, b);
+
+        CHECK(ka == kb && memcmp(a, b, ka * sizeof(uint32_t)) == 0,
+              "AVX-512 bounded compaction matches the portable compaction");
+    }
+#endif
+}
+
+
+/**
+ * @brief Returns how many steps separate two states of the same generator, from fast_loop.
+ */
+static uint64_t steps_between(const biski64_state* before, const biski64_state* after) {
+    const uint64_t weyl = 0x9999999999999999ULL;
+    uint64_t inverse = weyl;  // Newton iteration for the inverse of an odd number mod 2^64.
+    for (int i = 0; i < 5; ++i)
+        inverse *= 2 - weyl * inverse;
+    return (after->fast_loop - before->fast_loop) * inverse;
+}
+
+
+/**
+ * @brief Checks packed small-range draws for range, uniformity and generator step savings.
+ */
+static void test_packed_small_range(void) {
+    enum { N = 18 * 1000 };
+    static uint32_t dice[N];
+
+    biski64_state state, start;
+    biski64_seed(&state, 606);
+    start = state;
+    biski64_fill_small_range(&state, dice, N, 6);
+
+    int counts[6] = { 0 };
+    int ok = 1;
+    for (int i = 0; i < N; ++i) {
+        ok &= (dice[i] < 6);
+        counts[dice[i] < 6 ? dice[i] : 0]++;
+    }
+    for (int v = 0; v < 6; ++v)
+        ok &= (counts[v] > 2700 && counts[v] < 3300);
+
+    CHECK(ok, "biski64_fill_small_range dice are in range and roughly uniform");
+    CHECK(steps_between(&start, &state) < 1010, "biski64_fill_small_range packs 18 dice per step");
+
+    const uint32_t ranges[4] = { 52, 51, 50, 49 };
+    uint32_t hand[4];
+    int hand_ok = 1;
+    for (int i = 0; i < 1000; ++i) {
+        biski64_bounded_multi(&state, ranges, hand, 4);
+        for (int c = 0; c < 4; ++c)
+            hand_ok &= (hand[c] < ranges[c]);
+    }
+    CHECK(hand_ok, "biski64_bounded_multi values stay below their own ranges");
+
+    uint32_t rolls[64];
+    int roll_counts[6] = { 0 };
+    int packed_ok = 1;
+    for (int i = 0; i < 1800; ++i) {
+        biski64_bounded_packed(&state, 6, rolls, 10);
+        for (int c = 0; c < 10; ++c) {
+            packed_ok &= (rolls[c] < 6);
+            roll_counts[rolls[c] < 6 ? rolls[c] : 0]++;
+        }
+    }
+    for (int v = 0; v < 6; ++v)
+        packed_ok &= (roll_counts[v] > 2700 && roll_counts[v] < 3300);
+    CHECK(packed_ok, "biski64_bounded_packed values are in range and roughly uniform");
+
+    // 2^64 wraps product to 0: every output is accepted and its bits are the 64 flips.
+    long ones = 0;
+    int flips_ok = 1;
+    start = state;
+    for (int i = 0; i < 1000; ++i) {
+        biski64_bounded_packed(&state, 2, rolls, 64);
+        for (int c = 0; c < 64; ++c) {
+            flips_ok &= (rolls[c] < 2);
+            ones += rolls[c];
+        }
+    }
+    CHECK(flips_ok && ones > 31000 && ones < 33000 && steps_between(&start, &state) == 1000,
+          "biski64_bounded_packed draws 64 coin flips from each output without rejection");
+}
+
+
+/**
+ * @brief Checks interval bounds, the bit layout and kernel independence of the float fills.
+ */
+static void test_fill_double_and_float(void) {
+    enum { N = 16 * 500 + 11 };
+    static double d[N], d_open[N], d_ref[N];
+    static float f[N], f_open[N], f_ref[N];
+    static uint64_t raw[N];
+
+    biski64x8_state x8, ref;
+    biski64x8_seed(&x8, 8080);
+    ref = x8;
+    biski64x8_fill_double(&x8, d, N);
+    biski64x8_fill(&ref, raw, N);
+
+    int layout_ok = 1;
+    for (int i = 0; i < N; ++i)
+        layout_ok &= (d[i] == (double)(raw[i] >> 12) * 0x1p-52);
+    CHECK(layout_ok, "biski64x8_fill_double maps output j to (output >> 12) * 2^-52");
+
+    biski64x8_fill_double_open(&x8, d_open, N);
+    biski64x8_fill_float(&x8, f, N);
+    biski64x8_fill_float_open(&x8, f_open, N);
+
+    int range_ok = 1;
+    for (int i = 0; i < N; ++i) {
+        range_ok &= (d_open[i] > 0.0 && d_open[i] < 1.0);
+        range_ok &= (f[i] >= 0.0f && f[i] < 1.0f);
+        range_ok &= (f_open[i] > 0.0f && f_open[i] < 1.0f);
+    }
+    CHECK(range_ok, "open-interval fills exclude 0 and 1, half-open fills exclude 1");
+
+    int kernels_ok = 1;
+    for (int t = 0; t <= (int)biski64_kernel_in_use(); ++t) {
+        biski64x8_seed(&x8, 8081);
+        biski64x8_seed(&ref, 8081);
+        biski64_kernel_tables[t].fill_double(&x8, d, N, 1.0);
+        biski64x8_fill_double_scalar(&ref, d_ref, N, 1.0);
+        biski64_kernel_tables[t].fill_float(&x8, f, N, 1.0f - 0x1p-24f);
+        biski64x8_fill_float_scalar(&ref, f_ref, N, 1.0f - 0x1p-24f);
+        kernels_ok &= (memcmp(d, d_ref, sizeof(d)) == 0) && (memcmp(f, f_ref, sizeof(f)) == 0);
+    }
+    CHECK(kernels_ok, "double and float kernels up to the bound tier match the scalar kernel");
+}
+
+
+/**
+ * @brief Checks that dense floating-point values reach below 2^-53 with full mantissas.
+ */
+static void test_dense_floating_point(void) {
+    enum { N = 200000 };
+    static double d[N];
+    static float f[N];
+
+    biski64x8_state x8;
+    biski64x8_seed(&x8, 1729);
+    biski64x8_fill_double_dense(&x8, d, N);
+    biski64x8_fill_float_dense(&x8, f, N);
+
+    biski64_state state;
+    biski64_seed(&state, 1729);
+
+    int range_ok = 1, fine_mantissa = 0;
+    long below_half = 0, below_tiny = 0;
+    for (int i = 0; i < N; ++i) {
+        const double scalar = biski64_next_double_dense(&state);
+        const float scalar_f = biski64_next_float_dense(&state);
+        range_ok &= (d[i] >= 0.0 && d[i] < 1.0 && f[i] >= 0.0f && f[i] < 1.0f);
+        range_ok &= (scalar >= 0.0 && scalar < 1.0 && scalar_f >= 0.0f && scalar_f < 1.0f);
+
+        below_half += (d[i] < 0.5);
+        below_tiny += (d[i] < 0x1p-12);
+        // Values below 2^-12 whose low mantissa bits are set are not multiples of 2^-53.
+        fine_mantissa |= (d[i] < 0x1p-12 && d[i] * 0x1p53 != (double)(uint64_t)(d[i] * 0x1p53));
+    }
+
+    CHECK(range_ok, "dense doubles and floats stay in [0, 1)");
+    CHECK(below_half > N / 2 - 2000 && below_half < N / 2 + 2000 && below_tiny > 10 && below_tiny < 120,
+          "dense doubles have geometric binade frequencies");
+    CHECK(fine_mantissa, "dense doubles below 2^-12 carry bits finer than 2^-53");
+}
+
+
+/**
+ * @brief Checks the moments and tail mass of the ziggurat normal sampler, and that the
+ * vectorized candidate passes agree with the portable one.
+ */
+static void test_normal_ziggurat(void) {
+    enum { N = 400000 };
+    static double z[N];
+    static uint64_t raw[BISKI64_BATCH_CHUNK];
+    static double ref[BISKI64_BATCH_CHUNK], cand[BISKI64_BATCH_CHUNK];
+
+    biski64x8_state x8;
+    biski64x8_seed(&x8, 2718);
+    biski64x8_fill_normal(&x8, z, N, 0.0, 1.0);
+
+    double sum = 0.0, sum_sq = 0.0;
+    long beyond_2 = 0, beyond_r = 0;
+    for (int i = 0; i < N; ++i) {
+        sum += z[i];
+        sum_sq += z[i] * z[i];
+        beyond_2 += (fabs(z[i]) > 2.0);
+        beyond_r += (fabs(z[i]) > BISKI64_ZIG_NORM_R);
+    }
+    const double mean = sum / N, var = sum_sq / N - mean * mean;
+
+    // P(|Z| > 2) = 0.0455, P(|Z| > R) = 2.58e-4.
+    CHECK(fabs(mean) < 0.01 && fabs(var - 1.0) < 0.01, "batch normals have mean 0 and variance 1");
+    CHECK(beyond_2 > 17500 && beyond_2 < 18900 && beyond_r > 60 && beyond_r < 150,
+          "batch normals have normal tail mass, including beyond the base layer");
+
+    biski64_state state;
+    biski64_seed(&state, 2718);
+    sum = sum_sq = 0.0;
+    for (int i = 0; i < N; ++i) {
+        const double v = 3.0 + 2.0 * biski64_normal(&state);
+        sum += v;
+        sum_sq += v * v;
+    }
+    CHECK(fabs(sum / N - 3.0) < 0.02 && fabs(sqrt(sum_sq / N - (sum / N) * (sum / N)) - 2.0) < 0.02,
+          "scalar normals scale to the requested mean and deviation");
+
+    int kernels_ok = 1;
+    for (int round = 0; round < 50; ++round) {
+        uint64_t ref_rejects[BISKI64_BATCH_CHUNK / 64] = {0}, rejects[BISKI64_BATCH_CHUNK / 64] = {0};
+        biski64x8_fill(&x8, raw, BISKI64_BATCH_CHUNK);
+        biski64_zig_candidates(biski64_zig_norm_x, 1.5, 2.0, raw, 0, BISKI64_BATCH_CHUNK - 3, ref, ref_rejects);
+#ifdef BISKI64_X86_SIMD
+        if (biski64_kernel_in_use() >= BISKI64_KERNEL_AVX2) {
+            biski64_zig_candidates_avx2(biski64_zig_norm_x, 1.5, 2.0, raw, BISKI64_BATCH_CHUNK - 3, cand, rejects);
+            kernels_ok &= (memcmp(ref, cand, (BISKI64_BATCH_CHUNK - 3) * sizeof(double)) == 0);
+            kernels_ok &= (memcmp(ref_rejects, rejects, sizeof(rejects)) == 0);
+        }
+        if (biski64_kernel_in_use() >= BISKI64_KERNEL_AVX512) {
+            memset(rejects, 0, sizeof(rejects));
+            biski64_zig_candidates_avx512(biski64_zig_norm_x, 1.5, 2.0, raw, BISKI64_BATCH_CHUNK - 3, cand, rejects);
+            kernels_ok &= (memcmp(ref, cand, (BISKI64_BATCH_CHUNK - 3) * sizeof(double)) == 0);
+            kernels_ok &= (memcmp(ref_rejects, rejects, sizeof(rejects)) == 0);
+        }
+#else
+        (void)cand;
+        (void)rejects;
+#endif
+    }
+    CHECK(kernels_ok, "normal candidate kernels up to the bound tier match the portable pass");
+}
+
+
+/**
+ * @brief Checks the exponential and Laplace samplers' moments and tails, and the exponential
+ * candidate kernels against the portable pass.
+ */
+static void test_exponential_and_laplace(void) {
+    enum { N = 400000 };
+    static double e[N], l[N];
+    static uint64_t raw[BISKI64_BATCH_CHUNK];
+    static double ref[BISKI64_BATCH_CHUNK], cand[BISKI64_BATCH_CHUNK];
+
+    biski64x8_state x8;
+    biski64x8_seed(&x8, 31337);
+    biski64x8_fill_exponential(&x8, e, N, 4.0);
+    biski64x8_fill_laplace(&x8, l, N, -1.0, 0.5);
+
+    double sum_e = 0.0, sum_l = 0.0, sum_sq_l = 0.0;
+    long beyond_r = 0, negative_e = 0, below_location = 0;
+    for (int i = 0; i < N; ++i) {
+        sum_e += e[i];
+        negative_e += (e[i] < 0.0);
+        beyond_r += (e[i] * 4.0 > BISKI64_ZIG_EXP_R);
+        sum_l += l[i];
+        sum_sq_l += (l[i] + 1.0) * (l[i] + 1.0);
+        below_location += (l[i] < -1.0);
+    }
+
+    // P(E > R) = 4.54e-4 for rate 1; Laplace(b = 0.5) has variance 0.5.
+    CHECK(negative_e == 0 && fabs(sum_e / N - 0.25) < 0.003, "batch exponentials have mean 1 / rate");
+    CHECK(beyond_r > 130 && beyond_r < 240, "batch exponentials reach past the base layer");
+    CHECK(fabs(sum_l / N + 1.0) < 0.005 && fabs(sum_sq_l / N - 0.5) < 0.01
+              && below_location > N / 2 - 1500 && below_location < N / 2 + 1500,
+          "batch Laplace variates are centred and have variance 2 b^2");
+
+    biski64_state state;
+    biski64_seed(&state, 31337);
+    double sum = 0.0, sum_abs = 0.0;
+    for (int i = 0; i < N; ++i) {
+        sum += biski64_exponential(&state);
+        sum_abs += fabs(biski64_laplace(&state, 0.0, 2.0));
+    }
+    CHECK(fabs(sum / N - 1.0) < 0.01 && fabs(sum_abs / N - 2.0) < 0.02,
+          "scalar exponential and Laplace variates have the requested scale");
+
+    int kernels_ok = 1;
+    for (int round = 0; round < 50; ++round) {
+        uint64_t ref_rejects[BISKI64_BATCH_CHUNK / 64] = {0}, rejects[BISKI64_BATCH_CHUNK / 64] = {0};
+        biski64x8_fill(&x8, raw, BISKI64_BATCH_CHUNK);
+        biski64_zig_candidates(biski64_zig_exp_x, 1.0, 1.0, raw, 0, BISKI64_BATCH_CHUNK, ref, ref_rejects);
+#ifdef BISKI64_X86_SIMD
+        if (biski64_kernel_in_use() >= BISKI64_KERNEL_AVX2) {
+            biski64_zig_candidates_avx2(biski64_zig_exp_x, 1.0, 1.0, raw, BISKI64_BATCH_CHUNK, cand, rejects);
+            kernels_ok &= (memcmp(ref, cand, sizeof(ref)) == 0 && memcmp(ref_rejects, rejects, sizeof(rejects)) == 0);
+        }
+        if (biski64_kernel_in_use() >= BISKI64_KERNEL_AVX512) {
+            memset(rejects, 0, sizeof(rejects));
+            biski64_zig_candidates_avx512(biski64_zig_exp_x, 1.0, 1.0, raw, BISKI64_BATCH_CHUNK, cand, rejects);
+            kernels_ok &= (memcmp(ref, cand, sizeof(ref)) == 0 && memcmp(ref_rejects, rejects, sizeof(rejects)) == 0);
+        }
+#else
+        (void)cand;
+        (void)rejects;
+#endif
+    }
+    CHECK(kernels_ok, "exponential candidate kernels up to the bound tier match the portable pass");
+}
+
+
+/**
+ * @brief Checks the moments of the Gamma family, for shapes below and above 1, in scalar and
+ * batch form.
+ */
+static void test_gamma_family(void) {
+    enum { N = 200000 };
+    static double g[N];
+
+    biski64x8_state x8;
+    biski64x8_seed(&x8, 4242);
+    biski64_state state;
+    biski64_seed(&state, 4242);
+
+    const double shapes[] = { 0.3, 1.0, 2.5, 40.0 };
+    int gamma_ok = 1;
+    for (int s = 0; s < 4; ++s) {
+        const double k = shapes[s], theta = 1.5;
+        biski64_gamma_params params;
+        biski64_gamma_init(&params, k, theta);
+        biski64x8_fill_gamma(&x8, &params, g, N);
+
+        double sum = 0.0, sum_sq = 0.0, scalar_sum = 0.0;
+        int positive = 1;
+        for (int i = 0; i < N; ++i) {
+            sum += g[i];
+            sum_sq += g[i] * g[i];
+            positive &= (g[i] > 0.0);
+            scalar_sum += biski64_gamma_sample(&state, &params);
+        }
+        const double mean = sum / N, var = sum_sq / N - mean * mean;
+        gamma_ok &= positive;
+        gamma_ok &= fabs(mean / (k * theta) - 1.0) < 0.02 && fabs(var / (k * theta * theta) - 1.0) < 0.04;
+        gamma_ok &= fabs(scalar_sum / N / (k * theta) - 1.0) < 0.02;
+    }
+    CHECK(gamma_ok, "Gamma variates have mean k theta and variance k theta^2");
+
+    // Beta(2, 5): mean 2/7, variance 10 / (49 * 8).
+    biski64x8_fill_beta(&x8, 2.0, 5.0, g, N);
+    double sum = 0.0, sum_sq = 0.0;
+    int in_unit = 1;
+    for (int i = 0; i < N; ++i) {
+        sum += g[i];
+        sum_sq += g[i] * g[i];
+        in_unit &= (g[i] > 0.0 && g[i] < 1.0);
+    }
+    CHECK(in_unit && fabs(sum / N - 2.0 / 7.0) < 0.003 && fabs(sum_sq / N - (sum / N) * (sum / N) - 10.0 / 392.0) < 0.001,
+          "Beta variates lie in (0, 1) with the right mean and variance");
+
+    // Chi-square(3) has mean 3 and variance 6; Student-t(5) has variance 5/3.
+    biski64x8_fill_chi_square(&x8, 3.0, g, N);
+    sum = sum_sq = 0.0;
+    for (int i = 0; i < N; ++i) {
+        sum += g[i];
+        sum_sq += g[i] * g[i];
+    }
+    CHECK(fabs(sum / N - 3.0) < 0.03 && fabs(sum_sq / N - (sum / N) * (sum / N) - 6.0) < 0.15,
+          "chi-square variates have mean k and variance 2k");
+
+    biski64x8_fill_student_t(&x8, 5.0, g, N);
+    sum = sum_sq = 0.0;
+    double scalar_sum_sq = 0.0;
+    for (int i = 0; i < N; ++i) {
+        sum += g[i];
+        sum_sq += g[i] * g[i];
+        const double t = biski64_student_t(&state, 5.0);
+        scalar_sum_sq += t * t;
+    }
+    CHECK(fabs(sum / N) < 0.01 && fabs(sum_sq / N - 5.0 / 3.0) < 0.06 && fabs(scalar_sum_sq / N - 5.0 / 3.0) < 0.06,
+          "Student-t variates are centred with variance nu / (nu - 2)");
+
+    // Dirichlet(1, 2, 3): rows sum to 1 and component i has mean alpha_i / 6.
+    enum { ROWS = 50000 };
+    const double alpha[3] = { 1.0, 2.0, 3.0 };
+    double col_sum[3] = { 0.0, 0.0, 0.0 }, one[3];
+    biski64x8_fill_dirichlet(&x8, alpha, 3, g, ROWS);
+    int rows_ok = 1;
+    for (int r = 0; r < ROWS; ++r) {
+        rows_ok &= fabs(g[3 * r] + g[3 * r + 1] + g[3 * r + 2] - 1.0) < 1e-12;
+        for (int i = 0; i < 3; ++i)
+            col_sum[i] += g[3 * r + i];
+    }
+    biski64_dirichlet(&state, alpha, 3, one);
+    rows_ok &= fabs(one[0] + one[1] + one[2] - 1.0) < 1e-12;
+    CHECK(rows_ok && fabs(col_sum[0] / ROWS - 1.0 / 6.0) < 0.005 && fabs(col_sum[2] / ROWS - 0.5) < 0.005,
+          "Dirichlet rows sum to 1 with means alpha_i / sum(alpha)");
+}
+
+
+/**
+ * @brief Returns the largest gap between the empirical frequencies of counts[0..len) and the
+ * given log probability mass function.
+ */
+static double max_pmf_gap(const uint64_t* draws, size_t n, size_t len, double (*log_pmf)(double, const double*), const double* args) {
+    static double freq[256];
+    memset(freq, 0, sizeof(freq));
+    for (size_t i = 0; i < n; ++i)
+        if (draws[i] < len)
+            freq[draws[i]] += 1.0 / (double)n;
+
+    double gap = 0.0;
+    for (size_t k = 0; k < len; ++k) {
+        const double d = fabs(freq[k] - exp(log_pmf((double)k, args)));
+        gap = (d > gap) ? d : gap;
+    }
+    return gap;
+}
+
+
+static double poisson_log_pmf(double k, const double* args) {
+    return -args[0] + k * log(args[0]) - lgamma(k + 1.0);
+}
+
+
+static double binomial_log_pmf(double k, const double* args) {
+    const double n = args[0], p = args[1];
+    return lgamma(n + 1.0) - lgamma(k + 1.0) - lgamma(n - k + 1.0) + k * log(p) + (n - k) * log(1.0 - p);
+}
+
+
+/**
+ * @brief Checks the Poisson and binomial samplers against their mass functions in both
+ * algorithm regimes, and that multinomial counts add up.
+ */
+static void test_count_samplers(void) {
+    enum { N = 400000 };
+    static uint64_t draws[N];
+
+    biski64x8_state x8;
+    biski64x8_seed(&x8, 8675309);
+    biski64_state state;
+    biski64_seed(&state, 8675309);
+
+    // Poisson: inversion (mu = 3.5) and PTRS (mu = 40).
+    const double mus[2] = { 3.5, 40.0 };
+    int poisson_ok = 1;
+    for (int t = 0; t < 2; ++t) {
+        biski64_poisson_params params;
+        biski64_poisson_init(&params, mus[t]);
+        biski64x8_fill_poisson(&x8, &params, draws, N);
+        poisson_ok &= max_pmf_gap(draws, N, 120, poisson_log_pmf, &mus[t]) < 0.003;
+
+        for (int i = 0; i < N; ++i)
+            draws[i] = biski64_poisson_sample(&state, &params);
+        poisson_ok &= max_pmf_gap(draws, N, 120, poisson_log_pmf, &mus[t]) < 0.003;
+    }
+    CHECK(poisson_ok, "Poisson draws match the mass function for small and large means");
+
+    double sum = 0.0;
+    for (int i = 0; i < 10000; ++i)
+        sum += (double)biski64_poisson(&state, 1e6);
+    CHECK(fabs(sum / 10000 - 1e6) < 50.0, "Poisson draws with a mean of 10^6 are centred");
+
+    // Binomial: inversion (n = 30, p = 0.2), BTRD (n = 200, p = 0.3) and folded p (n = 200, p = 0.7).
+    const double cases[3][2] = { { 30.0, 0.2 }, { 200.0, 0.3 }, { 200.0, 0.7 } };
+    int binomial_ok = 1;
+    for (int t = 0; t < 3; ++t) {
+        biski64_binomial_params params;
+        biski64_binomial_init(&params, (uint64_t)cases[t][0], cases[t][1]);
+        biski64x8_fill_binomial(&x8, &params, draws, N);
+        binomial_ok &= max_pmf_gap(draws, N, 201, binomial_log_pmf, cases[t]) < 0.003;
+
+        for (int i = 0; i < N; ++i)
+            draws[i] = biski64_binomial_sample(&state, &params);
+        binomial_ok &= max_pmf_gap(draws, N, 201, binomial_log_pmf, cases[t]) < 0.003;
+    }
+    CHECK(binomial_ok, "binomial draws match the mass function for inversion, BTRD and p > 1/2");
+
+    int edges_ok = (biski64_binomial(&state, 50, 0.0) == 0 && biski64_binomial(&state, 50, 1.0) == 50);
+    sum = 0.0;
+    for (int i = 0; i < 10000; ++i) {
+        const uint64_t k = biski64_binomial(&state, 1000000000ULL, 0.25);
+        sum += (double)k;
+    }
+    edges_ok &= fabs(sum / 10000 - 2.5e8) < 300.0;
+    CHECK(edges_ok, "binomial handles p = 0, p = 1 and a billion trials");
+
+    const double probs[4] = { 0.1, 0.2, 0.3, 0.4 };
+    uint64_t counts[4], totals[4] = { 0, 0, 0, 0 };
+    int sums_ok = 1;
+    for (int i = 0; i < 10000; ++i) {
+        biski64_multinomial(&state, 1000, probs, 4, counts);
+        sums_ok &= (counts[0] + counts[1] + counts[2] + counts[3] == 1000);
+        for (int c = 0; c < 4; ++c)
+            totals[c] += counts[c];
+    }
+    CHECK(sums_ok && fabs(totals[0] / 1e7 - 0.1) < 0.001 && fabs(totals[3] / 1e7 - 0.4) < 0.001,
+          "multinomial counts sum to the trials with the requested proportions");
+}
+
+
+/**
+ * @brief Checks both geometric paths against their mass functions and the selector's rate.
+ */
+static void test_geometric_and_selector(void) {
+    enum { N = 400000 };
+    static uint64_t draws[N];
+
+    biski64x8_state x8;
+    biski64x8_seed(&x8, 60606);
+    biski64_state state;
+    biski64_seed(&state, 60606);
+
+    // p = 3/4 takes the trailing-zero path, p = 0.1 the logarithm.
+    const double ps[2] = { 0.75, 0.1 };
+    int geometric_ok = 1;
+    for (int t = 0; t < 2; ++t) {
+        biski64_geometric_params params;
+        biski64_geometric_init(&params, ps[t]);
+        geometric_ok &= (params.shift == (t == 0 ? 2u : 0u));
+
+        biski64x8_fill_geometric(&x8, &params, draws, N);
+        for (int pass = 0; pass < 2; ++pass) {
+            long freq[8] = { 0 };
+            for (int i = 0; i < N; ++i) {
+                const uint64_t k = pass ? biski64_geometric_sample(&state, &params) : draws[i];
+                if (k < 8)
+                    freq[k]++;
+            }
+            for (int k = 0; k < 8; ++k)
+                geometric_ok &= fabs((double)freq[k] / N - pow(1.0 - ps[t], k) * ps[t]) < 0.003;
+        }
+    }
+    geometric_ok &= (biski64_geometric(&state, 1.0) == 0 && biski64_geometric(&state, 0.0) == UINT64_MAX);
+    CHECK(geometric_ok, "geometric draws match (1 - p)^k p on the trailing-zero and log paths");
+
+    enum { ROWS = 10000000 };
+    static uint64_t picked[4096];
+    biski64_selector selector;
+    biski64_selector_init(&selector, &state, 0.01);
+
+    long selected = 0;
+    int increasing = 1;
+    uint64_t last = 0;
+    size_t got;
+    while ((got = biski64_selector_fill(&selector, &state, ROWS, picked, 4096)) > 0) {
+        for (size_t i = 0; i < got; ++i) {
+            increasing &= (selected == 0 && i == 0) || picked[i] > last;
+            last = picked[i];
+        }
+        selected += (long)got;
+    }
+    CHECK(increasing && last < ROWS && selected > 99000 && selected < 101000,
+          "selector visits increasing indices at the requested rate");
+}
+
+
+/**
+ * @brief Checks alias table sampling frequencies, including zero weights, and input validation.
+ */
+static void test_alias_table(void) {
+    enum { N = 1000000 };
+    static uint32_t picks[N];
+    const double weights[6] = { 1.0, 2.0, 3.0, 4.0, 0.0, 10.0 };
+
+    biski64_alias_table table;
+    CHECK(biski64_alias_init(&table, weights, 6) == 0, "alias table builds from unnormalized weights");
+
+    biski64x8_state x8;
+    biski64x8_seed(&x8, 1234);
+    biski64x8_fill_alias(&x8, &table, picks, N);
+
+    biski64_state state;
+    biski64_seed(&state, 1234);
+
+    long batch_freq[6] = { 0 }, scalar_freq[6] = { 0 };
+    for (int i = 0; i < N; ++i) {
+        batch_freq[picks[i]]++;
+        scalar_freq[biski64_alias_sample(&state, &table)]++;
+    }
+
+    int freq_ok = (batch_freq[4] == 0 && scalar_freq[4] == 0);
+    for (int k = 0; k < 6; ++k) {
+        freq_ok &= fabs((double)batch_freq[k] / N - weights[k] / 20.0) < 0.002;
+        freq_ok &= fabs((double)scalar_freq[k] / N - weights[k] / 20.0) < 0.002;
+    }
+    CHECK(freq_ok, "alias samples follow the weights and never pick a zero weight");
+    biski64_alias_free(&table);
+
+    const double bad[2] = { 0.0, -1.0 };
+    CHECK(biski64_alias_init(&table, bad, 2) == -1 && biski64_alias_init(&table, bad, 1) == -1 && table.entries == NULL,
+          "alias table rejects negative and all-zero weights");
+}
+
+
+/**
+ * @brief Checks the dynamic weighted sampler's frequencies across single and bulk updates,
+ * and that zero-weight items are never drawn.
+ */
+static void test_weighted_sampler(void) {
+    enum { ITEMS = 1000, N = 400000 };
+    static double weights[ITEMS];
+    static size_t picks[N];
+    for (int i = 0; i < ITEMS; ++i)
+        weights[i] = (double)(i % 10);
+
+    biski64_weighted sampler;
+    CHECK(biski64_weighted_init(&sampler, weights, ITEMS) == 0 && fabs(biski64_weighted_total(&sampler) - 4500.0) < 1e-9,
+          "weighted sampler builds with the right total");
+
+    biski64_state state;
+    biski64_seed(&state, 777);
+    biski64x8_state x8;
+    biski64x8_seed(&x8, 777);
+
+    // Move all the mass onto items 3 (weight 1) and 998 (weight 3) with single and bulk updates.
+    for (int i = 0; i < ITEMS; ++i)
+        biski64_weighted_set(&sampler, (size_t)i, 0.0);
+    CHECK(biski64_weighted_total(&sampler) == 0.0 && biski64_weighted_sample(&state, &sampler) == ITEMS,
+          "weighted sampler reports an empty distribution once every weight is zero");
+
+    const size_t idx[2] = { 3, 998 };
+    const double w[2] = { 1.0, 3.0 };
+    biski64_weighted_update(&sampler, idx, w, 2);
+
+    long count_3 = 0, count_998 = 0, other = 0;
+    biski64x8_fill_weighted(&x8, &sampler, picks, N);
+    for (int i = 0; i < N; ++i) {
+        count_3 += (picks[i] == 3);
+        count_998 += (picks[i] == 998);
+        const size_t s = biski64_weighted_sample(&state, &sampler);
+        count_3 += (s == 3);
+        count_998 += (s == 998);
+        other += (picks[i] != 3 && picks[i] != 998) + (s != 3 && s != 998);
+    }
+    CHECK(other == 0 && fabs((double)count_3 / (2.0 * N) - 0.25) < 0.003,
+          "weighted draws follow the updated weights");
+
+    // A bulk update large enough to trigger a rebuild restores the original weights.
+    static size_t all[ITEMS];
+    for (int i = 0; i < ITEMS; ++i)
+        all[i] = (size_t)i;
+    biski64_weighted_update(&sampler, all, weights, ITEMS);
+
+    long zero_hits = 0, high = 0;
+    biski64x8_fill_weighted(&x8, &sampler, picks, N);
+    for (int i = 0; i < N; ++i) {
+        zero_hits += (picks[i] % 10 == 0);
+        high += (picks[i] % 10 == 9);
+    }
+    CHECK(zero_hits == 0 && fabs((double)high / N - 0.2) < 0.003,
+          "bulk updates rebuild the tree and zero weights are never drawn");
+
+    biski64_weighted_free(&sampler);
+
+    // Removing weights of very different sizes, largest first, leaves rounding residue in an
+    // incrementally updated total; the sampler must still report an empty distribution.
+    const double spread[3] = { 1.0, 1e-6, 1e-12 };
+    CHECK(biski64_weighted_init(&sampler, NULL, 100) == 0, "weighted sampler builds with all-zero weights");
+    for (size_t i = 0; i < 3; ++i)
+        biski64_weighted_set(&sampler, i, spread[i]);
+    for (size_t i = 0; i < 3; ++i)
+        biski64_weighted_set(&sampler, i, 0.0);
+    int empty = (biski64_weighted_sample(&state, &sampler) == 100);
+    biski64x8_fill_weighted(&x8, &sampler, picks, 64);
+    for (int i = 0; i < 64; ++i)
+        empty &= (picks[i] == 100);
+    CHECK(empty, "weighted sampler is empty after removing weights of very different sizes");
+    biski64_weighted_free(&sampler);
+}
+
+
+/**
+ * @brief Checks Zipf ranks against the exact mass function and the Pareto and log-normal
+ * samplers' quantiles.
+ */
+static void test_heavy_tailed(void) {
+    enum { N = 400000 };
+    static uint64_t keys[N];
+    static double sizes[N];
+
+    biski64x8_state x8;
+    biski64x8_seed(&x8, 5150);
+    biski64_state state;
+    biski64_seed(&state, 5150);
+
+    const double exponents[3] = { 0.8, 1.0, 1.5 };
+    int zipf_ok = 1;
+    for (int t = 0; t < 3; ++t) {
+        const uint64_t ranks = 1000;
+        double norm = 0.0;
+        for (uint64_t k = 1; k <= ranks; ++k)
+            norm += pow((double)k, -exponents[t]);
+
+        biski64_zipf_params params;
+        biski64_zipf_init(&params, ranks, exponents[t]);
+        biski64x8_fill_zipf(&x8, &params, keys, N);
+
+        long freq[6] = { 0 }, scalar_freq[6] = { 0 };
+        for (int i = 0; i < N; ++i) {
+            zipf_ok &= (keys[i] >= 1 && keys[i] <= ranks);
+            if (keys[i] <= 5)
+                freq[keys[i]]++;
+            const uint64_t k = biski64_zipf_sample(&state, &params);
+            if (k <= 5)
+                scalar_freq[k]++;
+        }
+        for (int k = 1; k <= 5; ++k) {
+            const double expected = pow((double)k, -exponents[t]) / norm;
+            zipf_ok &= fabs((double)freq[k] / N - expected) < 0.003;
+            zipf_ok &= fabs((double)scalar_freq[k] / N - expected) < 0.003;
+        }
+    }
+    CHECK(zipf_ok, "Zipf ranks follow k^-s for exponents below, at and above 1");
+
+    biski64_zipf_params huge;
+    biski64_zipf_init(&huge, 300000000ULL, 0.99);
+    biski64x8_fill_zipf(&x8, &huge, keys, N);
+    int huge_ok = 1;
+    long deep = 0;
+    for (int i = 0; i < N; ++i) {
+        huge_ok &= (keys[i] >= 1 && keys[i] <= 300000000ULL);
+        deep += (keys[i] > 1000000);
+    }
+    CHECK(huge_ok && deep > 0, "Zipf ranks over 3 * 10^8 keys stay in range and reach the tail");
+
+    // Pareto(x_m = 2, alpha = 3): P(X > 4) = 1/8. Log-normal(0, 0.5): median 1.
+    biski64x8_fill_pareto(&x8, sizes, N, 2.0, 3.0);
+    long above = 0, below_min = 0;
+    for (int i = 0; i < N; ++i) {
+        above += (sizes[i] > 4.0);
+        below_min += (sizes[i] < 2.0);
+    }
+    long scalar_above = 0;
+    for (int i = 0; i < N; ++i)
+        scalar_above += (biski64_pareto(&state, 2.0, 3.0) > 4.0);
+    CHECK(below_min == 0 && fabs((double)above / N - 0.125) < 0.002 && fabs((double)scalar_above / N - 0.125) < 0.002,
+          "Pareto variates have the requested minimum and tail index");
+
+    biski64x8_fill_lognormal(&x8, sizes, N, 0.0, 0.5);
+    long under_median = 0, scalar_under = 0;
+    for (int i = 0; i < N; ++i) {
+        under_median += (sizes[i] < 1.0);
+        scalar_under += (biski64_lognormal(&state, 0.0, 0.5) < exp(0.5));
+    }
+    // P(Z < 1) = 0.8413 for the scalar check at exp(sigma).
+    CHECK(fabs((double)under_median / N - 0.5) < 0.003 && fabs((double)scalar_under / N - 0.8413) < 0.003,
+          "log-normal variates have median exp(mu) and the right spread");
+}
+
+
+/**
+ * @brief Checks Gumbel-max sampling against softmax probabilities, the top-k and greedy
+ * variants, and that every kernel tier picks the same indices.
+ */
+static void test_gumbel_max(void) {
+    enum { LOGITS = 37, DRAWS = 100000 };
+    static float logits[LOGITS];
+    for (int i = 0; i < LOGITS; ++i)
+        logits[i] = (i % 5 == 3) ? -INFINITY : (float)(i % 7) * 0.25f;
+
+    int log_ok = 1;
+    for (double x = 1e-300; x < 1e300; x *= 1.37)
+        log_ok &= fabs(biski64_gumbel_log(x) - log(x)) <= 1e-12 * fabs(log(x)) + 1e-15;
+    CHECK(log_ok, "Gumbel-max logarithm stays within 1e-12 relative error");
+
+    const double temperature = 0.7;
+    double norm = 0.0;
+    for (int i = 0; i < LOGITS; ++i)
+        norm += exp(logits[i] / temperature);
+
+    biski64x8_state x8;
+    biski64x8_seed(&x8, 271828);
+    static long freq[LOGITS + 1];
+    for (int d = 0; d < DRAWS; ++d)
+        freq[biski64x8_gumbel_sample(&x8, logits, LOGITS, temperature)]++;
+
+    int softmax_ok = (freq[LOGITS] == 0);
+    for (int i = 0; i < LOGITS; ++i)
+        softmax_ok &= fabs((double)freq[i] / DRAWS - exp(logits[i] / temperature) / norm) < 0.004;
+    CHECK(softmax_ok, "Gumbel-max samples follow softmax(logits / T) and skip masked logits");
+
+    int tiers_ok = 1;
+    static float wide[1005];
+    for (int i = 0; i < 1005; ++i)
+        wide[i] = (float)((i * 7919) % 101) * 0.01f;
+    for (int round = 0; round < 200; ++round) {
+        biski64x8_state ref_state = x8, tier_state;
+        biski64_gumbel_best ref = { -INFINITY, 1005 };
+        biski64_gumbel_scan(&ref_state, wide, 1005 - (size_t)round, 1.0, &ref);
+#ifdef BISKI64_X86_SIMD
+        if (biski64_kernel_in_use() >= BISKI64_KERNEL_AVX2 && __builtin_cpu_supports("fma")) {
+            biski64_gumbel_best b = { -INFINITY, 1005 };
+            tier_state = x8;
+            biski64_gumbel_scan_avx2(&tier_state, wide, 1005 - (size_t)round, 1.0, &b);
+            tiers_ok &= (b.index == ref.index && b.score == ref.score && memcmp(&tier_state, &ref_state, sizeof(ref_state)) == 0);
+        }
+        if (biski64_kernel_in_use() >= BISKI64_KERNEL_AVX512) {
+            biski64_gumbel_best b = { -INFINITY, 1005 };
+            tier_state = x8;
+            biski64_gumbel_scan_avx512(&tier_state, wide, 1005 - (size_t)round, 1.0, &b);
+            tiers_ok &= (b.index == ref.index && b.score == ref.score && memcmp(&tier_state, &ref_state, sizeof(ref_state)) == 0);
+        }
+#endif
+        (void)tier_state;
+        x8 = ref_state;
+    }
+    CHECK(tiers_ok, "Gumbel-max kernels up to the bound tier pick the same index as the portable scan");
+
+    // Top-3 of logits 0..9 keeps indices 7, 8, 9 with probabilities proportional to e^7, e^8, e^9.
+    float ramp[10];
+    for (int i = 0; i < 10; ++i)
+        ramp[i] = (float)i;
+    long top[10] = { 0 };
+    for (int d = 0; d < DRAWS; ++d)
+        top[biski64x8_gumbel_sample_top_k(&x8, ramp, 10, 3, 1.0)]++;
+    const double top_norm = exp(7.0) + exp(8.0) + exp(9.0);
+    int top_ok = (top[0] + top[1] + top[2] + top[3] + top[4] + top[5] + top[6] == 0);
+    for (int i = 7; i < 10; ++i)
+        top_ok &= fabs((double)top[i] / DRAWS - exp((double)i) / top_norm) < 0.005;
+    CHECK(top_ok, "top-k sampling is restricted to the k largest logits");
+
+    CHECK(biski64x8_gumbel_sample(&x8, logits, LOGITS, 0.0) == 6 && biski64x8_gumbel_sample_top_k(&x8, ramp, 10, 4, 0.0) == 9,
+          "zero temperature returns the greedy argmax");
+}
+
+
+/**
+ * @brief Checks that the Fisher-Yates shuffles produce every permutation equally often, agree
+ * across element sizes and keep the elements of large arrays.
+ */
+static void test_shuffle(void) {
+    enum { DRAWS = 240000 };
+    biski64_state state;
+    biski64_seed(&state, 1618);
+
+    // Lehmer-code each shuffle of 4 elements into 0..23.
+    long freq[24] = { 0 };
+    for (int d = 0; d < DRAWS; ++d) {
+        uint32_t a[4] = { 0, 1, 2, 3 };
+        biski64_shuffle_u32(&state, a, 4);
+        int code = 0;
+        for (int i = 0; i < 4; ++i) {
+            int smaller = 0;
+            for (int j = i + 1; j < 4; ++j)
+                smaller += (a[j] < a[i]);
+            code = code * (4 - i) + smaller;
+        }
+        freq[code]++;
+    }
+    int uniform = 1;
+    for (int p = 0; p < 24; ++p)
+        uniform &= (freq[p] > 9500 && freq[p] < 10500);
+    CHECK(uniform, "shuffles of 4 elements hit all 24 permutations equally often");
+
+    // Element 0 of a larger array lands in each third equally often.
+    enum { BIG = 3000 };
+    static uint32_t big[BIG];
+    long thirds[3] = { 0, 0, 0 };
+    for (int d = 0; d < 3000; ++d) {
+        for (uint32_t i = 0; i < BIG; ++i)
+            big[i] = i;
+        biski64_shuffle_u32(&state, big, BIG);
+        for (int i = 0; i < BIG; ++i)
+            if (big[i] == 0)
+                thirds[i / 1000]++;
+    }
+    CHECK(thirds[0] > 880 && thirds[0] < 1120 && thirds[2] > 880 && thirds[2] < 1120,
+          "shuffled positions are uniform");
+
+    enum { WIDE = 1000003 };
+    static uint32_t a32[WIDE];
+    static uint64_t a64[WIDE];
+    static struct { uint32_t key; char pad[20]; } a24[WIDE];
+    for (uint32_t i = 0; i < WIDE; ++i) {
+        a32[i] = i;
+        a64[i] = i;
+        a24[i].key = i;
+    }
+    biski64_state s32, s64, s24;
+    biski64_seed(&s32, 99);
+    s64 = s24 = s32;
+    biski64_shuffle_u32(&s32, a32, WIDE);
+    biski64_shuffle_u64(&s64, a64, WIDE);
+    biski64_shuffle(&s24, a24, WIDE, sizeof(a24[0]));
+
+    static unsigned char seen[WIDE];
+    memset(seen, 0, sizeof(seen));
+    int same = 1, moved = 0;
+    for (uint32_t i = 0; i < WIDE; ++i) {
+        same &= (a64[i] == a32[i] && a24[i].key == a32[i]);
+        seen[a32[i]] = 1;
+        moved += (a32[i] != i);
+    }
+    int all = 1;
+    for (uint32_t i = 0; i < WIDE; ++i)
+        all &= seen[i];
+    CHECK(same && all && moved > WIDE - 10, "32-bit, 64-bit and generic shuffles apply the same permutation");
+}
+
+
+/**
+ * @brief Checks that the bucket-scatter shuffle is a uniform permutation that depends only on
+ * the seed and the number of parts.
+ */
+static void test_parallel_shuffle(void) {
+    enum { DRAWS = 120000 };
+
+    // Four elements in four buckets from two parts exercise every phase; count the 24 outcomes.
+    long freq[24] = { 0 };
+    for (int d = 0; d < DRAWS; ++d) {
+        uint32_t a[4] = { 0, 1, 2, 3 };
+        biski64_scatter_shuffle((unsigned char*)a, 4, sizeof(uint32_t), (uint64_t)d, 2, 2);
+        int code = 0;
+        for (int i = 0; i < 4; ++i) {
+            int smaller = 0;
+            for (int j = i + 1; j < 4; ++j)
+                smaller += (a[j] < a[i]);
+            code = code * (4 - i) + smaller;
+        }
+        freq[code]++;
+    }
+    int uniform = 1;
+    for (int p = 0; p < 24; ++p)
+        uniform &= (freq[p] > 4650 && freq[p] < 5350);
+    CHECK(uniform, "bucket-scatter shuffles of 4 elements hit all 24 permutations equally often");
+
+    enum { WIDE = 3000017 };
+    static uint32_t a[WIDE], b[WIDE];
+    static unsigned char seen[WIDE];
+    for (uint32_t i = 0; i < WIDE; ++i)
+        a[i] = b[i] = i;
+    int ok = biski64_parallel_shuffle(a, WIDE, sizeof(uint32_t), 42, 3) == 0 &&
+             biski64_parallel_shuffle(b, WIDE, sizeof(uint32_t), 42, 3) == 0;
+
+    memset(seen, 0, sizeof(seen));
+    int same = 1, moved = 0;
+    for (uint32_t i = 0; i < WIDE; ++i) {
+        same &= (a[i] == b[i]);
+        seen[a[i]] = 1;
+        moved += (a[i] != i);
+    }
+    int all = 1;
+    for (uint32_t i = 0; i < WIDE; ++i)
+        all &= seen[i];
+    CHECK(ok && same && all && moved > WIDE - 10, "parallel shuffle is a reproducible permutation");
+
+    // Element 0 must be able to land in any slice, not just the one it started in.
+    long thirds[3] = { 0, 0, 0 };
+    for (int d = 0; d < 3000; ++d) {
+        for (uint32_t i = 0; i < 3000; ++i)
+            a[i] = i;
+        biski64_scatter_shuffle((unsigned char*)a, 3000, sizeof(uint32_t), (uint64_t)d, 3, 3);
+        for (int i = 0; i < 3000; ++i)
+            if (a[i] == 0)
+                thirds[i / 1000]++;
+    }
+    CHECK(thirds[0] > 880 && thirds[0] < 1120 && thirds[2] > 880 && thirds[2] < 1120,
+          "bucket-scatter positions are uniform across slices");
+}
+
+
+/**
+ * @brief Checks that the table-driven small shuffles unrank every permutation exactly once, are
+ * uniform, and match the scalar index construction on the bound kernel.
+ */
+static void test_small_shuffle(void) {
+    // Every rank of 8! must give a different permutation; count them by Lehmer code.
+    static unsigned char seen[65536];
+    memset(seen, 0, sizeof(seen));
+    int distinct = 1;
+    for (uint32_t u = 0; u < 40320; ++u) {
+        uint64_t order;
+        const uint64_t split = biski64_perm8_parts(u, &order);
+        const uint64_t p = biski64_lookup8(split, order);
+        uint32_t code = 0;
+        for (int i = 0; i < 8; ++i) {
+            uint32_t smaller = 0;
+            for (int j = i + 1; j < 8; ++j)
+                smaller += (((p >> (8 * j)) & 0xFF) < ((p >> (8 * i)) & 0xFF));
+            code = code * (uint32_t)(8 - i) + smaller;
+        }
+        distinct &= (code < 40320 && !seen[code]);
+        seen[code < 40320 ? code : 0] = 1;
+    }
+    CHECK(distinct, "every rank of 8! unranks to a different permutation");
+
+    // Likewise every index of C(16, 8) must give a different 8-of-16 subset.
+    memset(seen, 0, sizeof(seen));
+    distinct = 1;
+    for (uint32_t s = 0; s < 12870; ++s) {
+        uint64_t low_split, high_split;
+        const int k = biski64_riffle16_parts(s, &low_split, &high_split);
+        uint32_t mask = 0;
+        for (int t = 0; t < k; ++t)
+            mask |= 1u << ((low_split >> (8 * t)) & 0xFF);
+        for (int t = 0; t < 8 - k; ++t)
+            mask |= 1u << ((high_split >> (8 * t)) & 0xFF);
+        distinct &= (__builtin_popcount(mask) == 8 && !seen[mask]);
+        seen[mask & 0xFFFF] = 1;
+    }
+    CHECK(distinct, "every index of C(16, 8) unranks to a different subset");
+
+    biski64_state state;
+    biski64_seed(&state, 2718);
+
+    enum { DRAWS = 240000 };
+    long freq[24] = { 0 };
+    for (int d = 0; d < DRAWS; ++d) {
+        uint32_t a[4] = { 0, 1, 2, 3 };
+        biski64_shuffle_small_u32(&state, a, 4);
+        freq[a[0] * 6 + (a[1] - (a[1] > a[0])) * 2 + (a[2] > a[3])]++;
+    }
+    int uniform = 1;
+    for (int p = 0; p < 24; ++p)
+        uniform &= (freq[p] > 9500 && freq[p] < 10500);
+    CHECK(uniform, "small shuffles of 4 elements hit all 24 permutations equally often");
+
+    // Element i lands in position j with probability 1/16 for every pair.
+    enum { SHUFFLES = 1600000 };
+    static long where[16][16];
+    memset(where, 0, sizeof(where));
+    for (int d = 0; d < SHUFFLES; ++d) {
+        uint8_t a[16];
+        for (int i = 0; i < 16; ++i)
+            a[i] = (uint8_t)i;
+        biski64_shuffle_small_u8(&state, a, 16);
+        for (int j = 0; j < 16; ++j)
+            where[a[j]][j]++;
+    }
+    uniform = 1;
+    for (int i = 0; i < 16; ++i)
+        for (int j = 0; j < 16; ++j)
+            uniform &= (where[i][j] > 98500 && where[i][j] < 101500);
+    CHECK(uniform, "small shuffles of 16 elements place every element uniformly");
+
+    // The bound kernel must apply the permutation the scalar construction describes.
+    int same = 1;
+    for (size_t n = 4; n <= 16; n *= 2) {
+        for (int d = 0; d < 1000; ++d) {
+            biski64_state copy = state;
+            uint8_t idx[16];
+            uint32_t a[16];
+            uint8_t b[16];
+            for (size_t i = 0; i < n; ++i)
+                a[i] = b[i] = (uint8_t)(100 + i);
+            biski64_small_indices(&copy, n, idx);
+            copy = state;
+            biski64_shuffle_small_u8(&copy, b, n);
+            biski64_shuffle_small_u32(&state, a, n);
+            for (size_t t = 0; t < n; ++t)
+                same &= (a[t] == 100u + idx[t] && b[t] == 100u + idx[t]);
+        }
+    }
+    CHECK(same, "small shuffles do not depend on the kernel in use");
+}
+
+
+/**
+ * @brief Tests the Feistel permutation: bijectivity, inverse, batch agreement and uniformity.
+ */
+static void test_feistel(void) {
+    static unsigned char seen[100003];
+    const uint64_t sizes[] = { 1, 2, 3, 17, 64, 1000, 65537, 100003 };
+    int bijective = 1, inverse = 1, batch = 1;
+    static uint64_t out[100003];
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        const uint64_t n = sizes[s];
+        biski64_feistel perm;
+        biski64_feistel_init(&perm, n, 42 + s);
+        memset(seen, 0, n);
+        for (uint64_t i = 0; i < n; ++i) {
+            const uint64_t v = biski64_feistel_at(&perm, i);
+            bijective &= (v < n && !seen[v < n ? v : 0]);
+            seen[v < n ? v : 0] = 1;
+            inverse &= (biski64_feistel_position(&perm, v) == i);
+        }
+        // Start at 3 so the vector paths see an unaligned start and a scalar tail.
+        biski64_feistel_fill(&perm, n > 3 ? 3 : 0, out, n > 3 ? n - 3 : n);
+        for (uint64_t i = 0; i < (n > 3 ? n - 3 : n); ++i)
+            batch &= (out[i] == biski64_feistel_at(&perm, (n > 3 ? 3 : 0) + i));
+    }
+    CHECK(bijective, "Feistel permutations are bijections on [0, n)");
+    CHECK(inverse, "biski64_feistel_position() inverts biski64_feistel_at()");
+    CHECK(batch, "biski64_feistel_fill() matches biski64_feistel_at()");
+
+    // Large ranges stay in range, and the same seed gives the same permutation.
+    biski64_feistel a, b;
+    biski64_feistel_init(&a, 10000000000ULL, 7);
+    biski64_feistel_init(&b, 10000000000ULL, 7);
+    int in_range = 1, reproducible = 1;
+    biski64_feistel_fill(&a, 9999990000ULL, out, 10000);
+    for (uint64_t i = 0; i < 10000; ++i) {
+        in_range &= (out[i] < 10000000000ULL);
+        reproducible &= (out[i] == biski64_feistel_at(&b, 9999990000ULL + i));
+        in_range &= (biski64_feistel_position(&a, out[i]) == 9999990000ULL + i);
+    }
+    CHECK(in_range, "Feistel permutations of 10^10 stay in range and invert");
+    CHECK(reproducible, "Feistel permutations are reproducible from the seed");
+
+    // Across seeds, position 0 of a permutation of 10 is uniform.
+    long freq[10] = { 0 };
+    for (uint64_t seed = 0; seed < 100000; ++seed) {
+        biski64_feistel perm;
+        biski64_feistel_init(&perm, 10, seed);
+        freq[biski64_feistel_at(&perm, 0)]++;
+    }
+    int uniform = 1;
+    for (int v = 0; v < 10; ++v)
+        uniform &= (freq[v] > 9500 && freq[v] < 10500);
+    CHECK(uniform, "Feistel permutations send position 0 to every value equally often");
+}
+
+
+/**
+ * @brief Runs all biski64 C tests. Returns non-zero if any check fails.
+ */
+int main() {
+    printf("--- biski64 C Tests ---\n");
+
+    test_x4_lanes_match_scalar_streams();
+    test_x8_lanes_match_scalar_streams();
+    test_kernel_tiers_match_scalar();
+    test_fill_u64_matches_x4();
+    test_fill_bytes_nontemporal_matches_cached();
+    test_buffered_sequence();
+    test_u32_draws_use_both_halves();
+    test_bit_reservoir();
+    test_bounded_integers();
+    test_packed_small_range();
+    test_fill_double_and_float();
+    test_dense_floating_point();
+    test_normal_ziggurat();
+    test_exponential_and_laplace();
+    test_gamma_family();
+    test_count_samplers();
+    test_geometric_and_selector();
+    test_alias_table();
+    test_weighted_sampler();
+    test_heavy_tailed();
+    test_gumbel_max();
+    test_shuffle();
+    test_parallel_shuffle();
+    test_small_shuffle();
+    test_feistel();
+
+    printf("%s (%d failure%s)\n", failures ? "FAILED" : "OK", failures, failures == 1 ? "" : "s");
+    return failures ? 1 : 0;
+}
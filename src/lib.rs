@@ -6,8 +6,29 @@
 
 #![no_std]
 
+use core::sync::atomic::{AtomicUsize, Ordering};
 use rand_core::{RngCore, SeedableRng};
 
+/// The default size, in bytes, at which `fill_bytes` switches to non-temporal stores.
+pub const NONTEMPORAL_THRESHOLD_DEFAULT: usize = 1 << 22;
+
+static NONTEMPORAL_THRESHOLD: AtomicUsize = AtomicUsize::new(NONTEMPORAL_THRESHOLD_DEFAULT);
+
+/// Sets the buffer size at which `Biski64Rng::fill_bytes` switches to non-temporal stores.
+///
+/// Streaming stores bypass the cache hierarchy, so filling a multi-gigabyte buffer does not
+/// evict the working set from the last-level cache. The bytes produced are the same either way.
+/// Pass `usize::MAX` to disable streaming stores. The setting is process-wide and only has an
+/// effect on `x86_64`.
+pub fn set_nontemporal_threshold(bytes: usize) {
+    NONTEMPORAL_THRESHOLD.store(bytes, Ordering::Relaxed);
+}
+
+/// Returns the buffer size at which `Biski64Rng::fill_bytes` switches to non-temporal stores.
+pub fn nontemporal_threshold() -> usize {
+    NONTEMPORAL_THRESHOLD.load(Ordering::Relaxed)
+}
+
 // Helper struct for seeding. This is a complete SplitMix64 PRNG.
 struct SplitMix64 {
     state: u64,
@@ -116,6 +137,76 @@ impl Biski64Rng {
 
         rng
     }
+
+    /// Fills `dest` like `fill_bytes_via_next`, writing the 16-byte aligned body with
+    /// non-temporal stores.
+    ///
+    /// When `dest` is not 8-byte aligned each store is funnel-shifted from two consecutive
+    /// outputs, so the byte stream is identical to the cached path for any alignment.
+    #[cfg(target_arch = "x86_64")]
+    fn fill_bytes_nontemporal(&mut self, dest: &mut [u8]) {
+        use core::arch::x86_64::{__m128i, _mm_set_epi64x, _mm_sfence, _mm_stream_si128};
+
+        let tail = dest.len() % 8;
+        let (body, rest) = dest.split_at_mut(dest.len() - tail);
+
+        let head = body.as_ptr().align_offset(16).min(body.len());
+        let (head_bytes, aligned) = body.split_at_mut(head);
+        let (chunks, after) = aligned.split_at_mut(aligned.len() / 16 * 16);
+
+        // Output bytes not yet written, lowest byte first.
+        let mut carry = 0u64;
+        let mut carry_bytes = 0u32;
+
+        for byte in head_bytes.iter_mut() {
+            if carry_bytes == 0 {
+                carry = self.next_u64();
+                carry_bytes = 8;
+            }
+            *byte = carry as u8;
+            carry >>= 8;
+            carry_bytes -= 1;
+        }
+
+        let shift = 8 * carry_bytes;
+        for chunk in chunks.chunks_exact_mut(16) {
+            let mut lo = self.next_u64();
+            let mut hi = self.next_u64();
+            if shift != 0 {
+                let next_carry = hi >> (64 - shift);
+                hi = (hi << shift) | (lo >> (64 - shift));
+                lo = (lo << shift) | carry;
+                carry = next_carry;
+            }
+            // SAFETY: `chunk` is 16 bytes long and starts on a 16-byte boundary, and SSE2 is
+            // part of the x86_64 baseline.
+            unsafe {
+                _mm_stream_si128(
+                    chunk.as_mut_ptr() as *mut __m128i,
+                    _mm_set_epi64x(hi as i64, lo as i64),
+                );
+            }
+        }
+        // SAFETY: SSE is part of the x86_64 baseline.
+        unsafe { _mm_sfence() };
+
+        for byte in after.iter_mut() {
+            if carry_bytes == 0 {
+                carry = self.next_u64();
+                carry_bytes = 8;
+            }
+            *byte = carry as u8;
+            carry >>= 8;
+            carry_bytes -= 1;
+        }
+
+        // Same tail rule as `fill_bytes_via_next`: 5..7 bytes from `next_u64`, 1..4 from `next_u32`.
+        if tail > 4 {
+            rest.copy_from_slice(&self.next_u64().to_le_bytes()[..tail]);
+        } else if tail > 0 {
+            rest.copy_from_slice(&((self.next_u64() >> 32) as u32).to_le_bytes()[..tail]);
+        }
+    }
 }
 
 impl RngCore for Biski64Rng {
@@ -138,6 +229,11 @@ impl RngCore for Biski64Rng {
     }
 
     fn fill_bytes(&mut self, dest: &mut [u8]) {
+        #[cfg(target_arch = "x86_64")]
+        if dest.len() >= nontemporal_threshold() {
+            return self.fill_bytes_nontemporal(dest);
+        }
+
         rand_core::impls::fill_bytes_via_next(self, dest)
     }
 }
@@ -185,6 +281,102 @@ impl SeedableRng for Biski64Rng {
     }
 }
 
+/// A `Biski64Rng` that serves two 32-bit values from each 64-bit step.
+///
+/// `Biski64Rng::next_u32` keeps only the high half of an output. `Biski64Rng32` instead
+/// returns the low half first and keeps the high half for the next call, so 32-bit draws
+/// cost half a generator step. Its `next_u32` sequence is the little-endian 32-bit view of
+/// the wrapped generator's `next_u64` sequence, matching `biski64_next_u32()` in the C code.
+/// `next_u64` and `fill_bytes` are passed straight to the wrapped generator and leave any
+/// pending half in place.
+///
+/// # Example
+/// ```
+/// use biski64::Biski64Rng32;
+/// use rand_core::{RngCore, SeedableRng};
+///
+/// let mut rng = Biski64Rng32::seed_from_u64(42);
+/// let a = rng.next_u32(); // Steps the generator.
+/// let b = rng.next_u32(); // Served from the same step.
+///
+/// let mut values = [0u32; 100];
+/// rng.fill_u32(&mut values);
+/// ```
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct Biski64Rng32 {
+    rng: Biski64Rng,
+    spare: Option<u32>,
+}
+
+impl Biski64Rng32 {
+    /// Fills `dest` with 32-bit values, two per generator step.
+    ///
+    /// Produces exactly the values repeated `next_u32` calls would, including a pending
+    /// high half from an earlier call and leaving one pending when `dest` ends on a low half.
+    pub fn fill_u32(&mut self, dest: &mut [u32]) {
+        let rest = match (self.spare.take(), dest.split_first_mut()) {
+            (Some(spare), Some((first, tail))) => {
+                *first = spare;
+                tail
+            }
+            (spare, _) => {
+                self.spare = spare;
+                dest
+            }
+        };
+
+        let mut pairs = rest.chunks_exact_mut(2);
+        for pair in &mut pairs {
+            let output = self.rng.next_u64();
+            pair[0] = output as u32;
+            pair[1] = (output >> 32) as u32;
+        }
+
+        if let [last] = pairs.into_remainder() {
+            *last = self.next_u32();
+        }
+    }
+}
+
+impl From<Biski64Rng> for Biski64Rng32 {
+    /// Wraps an existing generator, e.g. one created by `Biski64Rng::from_seed_for_stream`.
+    fn from(rng: Biski64Rng) -> Self {
+        Self { rng, spare: None }
+    }
+}
+
+impl RngCore for Biski64Rng32 {
+    #[inline(always)]
+    fn next_u64(&mut self) -> u64 {
+        self.rng.next_u64()
+    }
+
+    #[inline(always)]
+    fn next_u32(&mut self) -> u32 {
+        match self.spare.take() {
+            Some(high) => high,
+            None => {
+                let output = self.rng.next_u64();
+                self.spare = Some((output >> 32) as u32);
+                output as u32
+            }
+        }
+    }
+
+    fn fill_bytes(&mut self, dest: &mut [u8]) {
+        self.rng.fill_bytes(dest)
+    }
+}
+
+impl SeedableRng for Biski64Rng32 {
+    type Seed = [u8; 32];
+
+    /// Creates a new `Biski64Rng32` wrapping `Biski64Rng::from_seed(seed)`.
+    fn from_seed(seed: Self::Seed) -> Self {
+        Biski64Rng::from_seed(seed).into()
+    }
+}
+
 
 #[cfg(test)]
 mod tests {
@@ -239,4 +431,53 @@ mod tests {
         assert_ne!(val0, val2, "Streams 0 and 2 should not produce the same first value");
         assert_ne!(val1, val2, "Streams 1 and 2 should not produce the same first value");
     }
+
+    #[test]
+    fn test_u32_draws_use_both_halves() {
+        let mut rng = Biski64Rng::seed_from_u64(2024);
+        let mut rng32 = Biski64Rng32::seed_from_u64(2024);
+
+        for _ in 0..100 {
+            let output = rng.next_u64();
+            assert_eq!(rng32.next_u32(), output as u32);
+            assert_eq!(rng32.next_u32(), (output >> 32) as u32);
+        }
+    }
+
+    #[test]
+    fn test_fill_u32_matches_next_u32() {
+        let mut filled = Biski64Rng32::seed_from_u64(7);
+        let mut single = filled.clone();
+        let mut buf = [0u32; 16];
+
+        // Odd lengths leave a pending half that the next call must start with.
+        for len in 0..12 {
+            filled.fill_u32(&mut buf[..len]);
+            for &value in &buf[..len] {
+                assert_eq!(value, single.next_u32());
+            }
+        }
+        assert_eq!(filled, single);
+    }
+
+    #[cfg(target_arch = "x86_64")]
+    #[test]
+    fn test_fill_bytes_nontemporal_matches_cached() {
+        // The streaming path must produce the same bytes for every alignment and tail length.
+        let mut a = [0u8; 4096 + 64];
+        let mut b = [0u8; 4096 + 64];
+
+        for offset in 0..16 {
+            for len in (4000..4100 - offset).step_by(7) {
+                let mut rng_a = Biski64Rng::seed_from_u64(len as u64);
+                let mut rng_b = rng_a.clone();
+
+                rand_core::impls::fill_bytes_via_next(&mut rng_a, &mut a[offset..offset + len]);
+                rng_b.fill_bytes_nontemporal(&mut b[offset..offset + len]);
+
+                assert_eq!(&a[offset..offset + len], &b[offset..offset + len]);
+                assert_eq!(rng_a, rng_b);
+            }
+        }
+    }
 }